@@ -3358,6 +3358,54 @@ Statement* Parser::ParseStatement(int depth, bool semi_colon)
       NextToken();
       break;
 
+    case SOCK_TCP_SET_NONBLOCK:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_TCP_SET_NONBLOCK);
+      NextToken();
+      break;
+
+    case SOCK_TCP_ACCEPT_NB:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_TCP_ACCEPT_NB);
+      NextToken();
+      break;
+
+    case SOCK_TCP_READ_NB:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_TCP_READ_NB);
+      NextToken();
+      break;
+
+    case SOCK_TCP_WRITE_NB:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_TCP_WRITE_NB);
+      NextToken();
+      break;
+
+    case SOCK_POLL_CREATE:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_POLL_CREATE);
+      NextToken();
+      break;
+
+    case SOCK_POLL_CTL:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_POLL_CTL);
+      NextToken();
+      break;
+
+    case SOCK_POLL_WAIT:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_POLL_WAIT);
+      NextToken();
+      break;
+
+    case SOCK_POLL_CLOSE:
+      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                               instructions::SOCK_POLL_CLOSE);
+      NextToken();
+      break;
+
     case SERL_CHAR:
       statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
                                                                instructions::SERL_CHAR);
@@ -5478,6 +5526,54 @@ Statement* Parser::ParseSystemStatement(int line_num, int line_pos, const std::w
      NextToken();
      break;
 
+  case SOCK_TCP_SET_NONBLOCK:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_TCP_SET_NONBLOCK);
+     NextToken();
+     break;
+
+  case SOCK_TCP_ACCEPT_NB:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_TCP_ACCEPT_NB);
+     NextToken();
+     break;
+
+  case SOCK_TCP_READ_NB:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_TCP_READ_NB);
+     NextToken();
+     break;
+
+  case SOCK_TCP_WRITE_NB:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_TCP_WRITE_NB);
+     NextToken();
+     break;
+
+  case SOCK_POLL_CREATE:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_POLL_CREATE);
+     NextToken();
+     break;
+
+  case SOCK_POLL_CTL:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_POLL_CTL);
+     NextToken();
+     break;
+
+  case SOCK_POLL_WAIT:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_POLL_WAIT);
+     NextToken();
+     break;
+
+  case SOCK_POLL_CLOSE:
+     statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
+                                                              instructions::SOCK_POLL_CLOSE);
+     NextToken();
+     break;
+
   case SERL_CHAR:
      statement = TreeFactory::Instance()->MakeSystemStatement(file_name, line_num, line_pos, GetLineNumber(), GetLinePosition(),
                                                               instructions::SERL_CHAR);
@@ -425,6 +425,14 @@ void Scanner::LoadKeywords()
   ident_map[L"HTTP3_REQUEST"] = HTTP3_REQUEST;
   ident_map[L"HTTP3_REQUEST_HDRS"] = HTTP3_REQUEST_HDRS;
   ident_map[L"HTTP3_CLOSE"] = HTTP3_CLOSE;
+  ident_map[L"SOCK_TCP_SET_NONBLOCK"] = SOCK_TCP_SET_NONBLOCK;
+  ident_map[L"SOCK_TCP_ACCEPT_NB"] = SOCK_TCP_ACCEPT_NB;
+  ident_map[L"SOCK_TCP_READ_NB"] = SOCK_TCP_READ_NB;
+  ident_map[L"SOCK_TCP_WRITE_NB"] = SOCK_TCP_WRITE_NB;
+  ident_map[L"SOCK_POLL_CREATE"] = SOCK_POLL_CREATE;
+  ident_map[L"SOCK_POLL_CTL"] = SOCK_POLL_CTL;
+  ident_map[L"SOCK_POLL_WAIT"] = SOCK_POLL_WAIT;
+  ident_map[L"SOCK_POLL_CLOSE"] = SOCK_POLL_CLOSE;
   ident_map[L"SERL_INT"] = SERL_INT;
   ident_map[L"SERL_FLOAT"] = SERL_FLOAT;
   ident_map[L"SERL_OBJ_INST"] = SERL_OBJ_INST;
@@ -777,6 +785,14 @@ void Scanner::CheckIdentifier(int index)
     case HTTP3_REQUEST:
     case HTTP3_REQUEST_HDRS:
     case HTTP3_CLOSE:
+    case SOCK_TCP_SET_NONBLOCK:
+    case SOCK_TCP_ACCEPT_NB:
+    case SOCK_TCP_READ_NB:
+    case SOCK_TCP_WRITE_NB:
+    case SOCK_POLL_CREATE:
+    case SOCK_POLL_CTL:
+    case SOCK_POLL_WAIT:
+    case SOCK_POLL_CLOSE:
     case SERL_INT:
     case SERL_FLOAT:
     case SERL_OBJ_INST:
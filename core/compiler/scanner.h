@@ -420,6 +420,15 @@ enum ScannerTokenType {
   HTTP3_REQUEST,
   HTTP3_REQUEST_HDRS,
   HTTP3_CLOSE,
+  // readiness event loop
+  SOCK_TCP_SET_NONBLOCK,
+  SOCK_TCP_ACCEPT_NB,
+  SOCK_TCP_READ_NB,
+  SOCK_TCP_WRITE_NB,
+  SOCK_POLL_CREATE,
+  SOCK_POLL_CTL,
+  SOCK_POLL_WAIT,
+  SOCK_POLL_CLOSE,
   // serialization
   SERL_CHAR,
   SERL_INT,
@@ -295,6 +295,15 @@ namespace instructions {
     // ordinal IS the wire id -- inserting anywhere else silently
     // renumbers every trap below it.
     HTTP2_REQUEST_HDRS,
-    HTTP3_REQUEST_HDRS
+    HTTP3_REQUEST_HDRS,
+    // readiness event loop
+    SOCK_TCP_SET_NONBLOCK,
+    SOCK_TCP_ACCEPT_NB,
+    SOCK_TCP_READ_NB,
+    SOCK_TCP_WRITE_NB,
+    SOCK_POLL_CREATE,
+    SOCK_POLL_CTL,
+    SOCK_POLL_WAIT,
+    SOCK_POLL_CLOSE
   };
 }
@@ -40,6 +40,79 @@ PageManager* JitAmd64::page_manager;
 void JitAmd64::Initialize(StackProgram* p) {
   JitCompiler::Initialize(p);
   page_manager = new PageManager;
+  InstallCachedCode();
+}
+
+const char* JitCodeCache::GetStamp() {
+  return "amd64 " __DATE__ " " __TIME__;
+}
+
+// Installs methods compiled by an earlier run (JitCodeCache::Open) before any
+// code runs: relocations are resolved against this process and call sites are
+// patched, so these methods are native from their first call.
+void JitAmd64::InstallCachedCode() {
+  JitCacheEntry entry;
+  while(JitCodeCache::Next(entry)) {
+    StackMethod* mthd = program->GetClass(entry.cls_id)->GetMethod(entry.mthd_id);
+    if(!mthd || mthd->GetNativeCode()) {
+      continue;
+    }
+
+    // float constants
+    const long float_count = entry.floats.empty() ? 1 : (long)entry.floats.size();
+    double* floats;
+#ifdef _WIN64
+    floats = (double*)VirtualAlloc(nullptr, sizeof(double) * float_count, MEM_COMMIT, PAGE_READWRITE);
+    if(!floats) {
+      std::wcerr << L"Unable to allocate JIT memory for float_consts!" << std::endl;
+      exit(1);
+    }
+#else
+    if(posix_memalign((void**)&floats, PAGE_SIZE, sizeof(double) * float_count)) {
+      std::wcerr << L"Unable to reallocate JIT memory!" << std::endl;
+      exit(1);
+    }
+#endif
+    floats[0] = 0.0;
+    for(size_t i = 0; i < entry.floats.size(); ++i) {
+      floats[i] = entry.floats[i];
+    }
+
+    // relocations
+    bool resolved = true;
+    for(size_t i = 0; resolved && i < entry.relocs.size(); ++i) {
+      const JitReloc &reloc = entry.relocs[i];
+      const size_t addr = JitCodeCache::Resolve(program, reloc, floats, float_count);
+      if(!addr || reloc.site < 0 || reloc.site + (int64_t)sizeof(int64_t) > (int64_t)entry.code.size()) {
+        resolved = false;
+      }
+      else {
+        memcpy(&entry.code[(size_t)reloc.site], &addr, sizeof(int64_t));
+      }
+    }
+
+    if(!resolved || !mthd->ClaimJitCompile()) {
+#ifdef _WIN64
+      VirtualFree(floats, 0, MEM_RELEASE);
+#else
+      free(floats);
+#endif
+      if(!resolved) {
+        JitCodeCache::Reject(entry);
+      }
+      continue;
+    }
+
+    const long code_size = (long)entry.code.size();
+    NativeCode* native_code = new NativeCode(page_manager->GetPage(entry.code.data(), code_size), code_size, floats);
+    for(size_t i = 0; i < entry.osr_entries.size(); ++i) {
+      native_code->AddOsrEntry(entry.osr_entries[i].first, entry.osr_entries[i].second);
+    }
+    mthd->SetNativeCode(native_code);
+    PatchCallSites(mthd, 1);
+    mthd->SetJitDone();
+    JitCodeCache::Installed();
+  }
 }
 
 void JitAmd64::Prolog() {
@@ -95,7 +168,7 @@ void JitAmd64::Prolog() {
   // Cache &stw_active in R12 (callee-saved) once per method. Each LBL's GC
   // safepoint poll then becomes a 5-byte `cmp byte [r12],0` instead of a 10-byte
   // movabs + 3-byte cmp — the per-label win in label-dense integer loops.
-  move_imm_reg((int64_t)MemoryManager::StwActiveAddr(), R12);
+  move_addr_reg((size_t)MemoryManager::StwActiveAddr(), R12);
 }
 
 void JitAmd64::Epilog() 
@@ -193,6 +266,61 @@ void JitAmd64::Epilog()
   }
 }
 
+void JitAmd64::SaveArguments() {
+#ifdef _WIN64    
+  move_reg_mem(RCX, CLS_ID, RBP);
+  move_reg_mem(RDX, MTHD_ID, RBP);
+  move_reg_mem(R8, CLASS_MEM, RBP);
+  move_reg_mem(R9, INSTANCE_MEM, RBP);
+#else
+  move_reg_mem(RDI, CLS_ID, RBP);
+  move_reg_mem(RSI, MTHD_ID, RBP);
+  move_reg_mem(RDX, CLASS_MEM, RBP);
+  move_reg_mem(RCX, INSTANCE_MEM, RBP);
+  move_reg_mem(R8, OP_STACK, RBP);
+  move_reg_mem(R9, STACK_POS, RBP);
+#endif
+}
+
+// On-stack replacement entries, one per loop header. Each stub builds the same
+// frame as the method entry but, in place of popping parameters, loads every
+// local from the interpreter frame (FRAME_MEM) and jumps to the loop label. At
+// a label the working stack is empty and no local is cached in a register, so
+// the stack slots are the whole state the loop body expects.
+void JitAmd64::EmitOsrEntries(long frame_space) {
+  for(std::unordered_set<long>::iterator iter = safepoint_lbl_indices.begin(); iter != safepoint_lbl_indices.end(); ++iter) {
+    const long lbl_index = *iter;
+#ifdef _DEBUG_JIT
+    std::wcout << L"  " << (++instr_count) << L": [<osr entry: lbl=" << lbl_index << L">]" << std::endl;
+#endif
+    osr_entries.push_back(std::pair<long, long>(lbl_index, code_index));
+
+    local_space = frame_space;
+    Prolog();
+    SaveArguments();
+    RegisterRoot();
+
+    RegisterHolder* mem_holder = GetRegister();
+    RegisterHolder* value_holder = GetRegister();
+    move_mem_reg(FRAME_MEM, RBP, mem_holder->GetRegister());
+    for(size_t i = 0; i < osr_locals.size(); ++i) {
+      const OsrLocal& local = osr_locals[i];
+      const long words = local.is_func ? 2 : 1;
+      for(long j = 0; j < words; ++j) {
+        move_mem_reg((local.id + 1 + j) * sizeof(size_t), mem_holder->GetRegister(), value_holder->GetRegister());
+        move_reg_mem(value_holder->GetRegister(), local.offset + j * sizeof(size_t), RBP);
+      }
+    }
+    ReleaseRegister(value_holder);
+    ReleaseRegister(mem_holder);
+
+    // jmp rel32 to the loop label
+    AddMachineCode(0xe9);
+    const long lbl_offset = method->GetInstruction(lbl_index)->GetOffset();
+    AddImm(lbl_offset - (code_index + 4));
+  }
+}
+
 void JitAmd64::RegisterRoot() {
   // calculate root address
   // note: the offset required to 
@@ -202,8 +330,14 @@ void JitAmd64::RegisterRoot() {
 #else
   const long offset = org_local_space + RED_ZONE + TMP_REG_5;
 #endif
-  // get to stack locals
+  // get to stack locals; LOOP below counts in RCX, so the address must not be
+  // held there (the pool order differs when emitting OSR entries)
   RegisterHolder* holder = GetRegister();
+  if(holder->GetRegister() == RCX) {
+    RegisterHolder* other = GetRegister();
+    ReleaseRegister(holder);
+    holder = other;
+  }
   move_reg_reg(RBP, holder->GetRegister());
   sub_imm_reg(-TMP_REG_5 + offset, holder->GetRegister());
 
@@ -1217,13 +1351,29 @@ long JitAmd64::EmitNewObjectInline(StackClass* cls) {
   move_reg_mem(RCX, TMP_REG_2, RBP);
   move_reg_mem(RDX, TMP_REG_3, RBP);
 
-  move_imm_reg((int64_t)MemoryManager::YoungOffsetAddr(), RBX);   // RBX = &young_offset
+#ifdef _TLAB_JIT_INLINE
+  // Thread-local bump: the TLAB sits at a fixed %fs-relative offset (initial-exec
+  // TLS), so the fast path needs no atomics. A miss falls to the slow path, which
+  // refills the buffer.
+  const int tlab_off = (int)MemoryManager::AllocBufferTlsOffset();
+  AddMachineCode(0x64); AddMachineCode(0x48); AddMachineCode(0x8B);
+  AddMachineCode(0x14); AddMachineCode(0x25); AddImm(tlab_off);       // mov rdx, fs:[tlab.top]
+  move_reg_reg(RDX, RCX);                             // RCX = raw_mem
+  add_imm_reg((int64_t)aligned_total, RCX);          // RCX = new top
+  AddMachineCode(0x64); AddMachineCode(0x48); AddMachineCode(0x3B);
+  AddMachineCode(0x0C); AddMachineCode(0x25); AddImm(tlab_off + 8);   // cmp rcx, fs:[tlab.end]
+  AddMachineCode(0x0f); AddMachineCode(0x87);                         // ja OVERFLOW
+  const long ja_pos = code_index; AddImm(0);
+  AddMachineCode(0x64); AddMachineCode(0x48); AddMachineCode(0x89);
+  AddMachineCode(0x0C); AddMachineCode(0x25); AddImm(tlab_off);       // mov fs:[tlab.top], rcx
+#else
+  move_addr_reg((size_t)MemoryManager::YoungOffsetAddr(), RBX);   // RBX = &young_offset
 
   const long retry_index = code_index;
   move_mem_reg(0, RBX, RAX);                          // RAX = young_offset (expected)
   move_reg_reg(RAX, RCX);                             // RCX = expected
   add_imm_reg((int64_t)aligned_total, RCX);          // RCX = new_offset
-  move_imm_reg((int64_t)MemoryManager::YoungRegionSizeAddr(), RDX);
+  move_addr_reg((size_t)MemoryManager::YoungRegionSizeAddr(), RDX);
   move_mem_reg(0, RDX, RDX);                          // RDX = young_region_size
   AddMachineCode(0x48); AddMachineCode(0x39); AddMachineCode(0xD1);   // cmp rcx, rdx
   AddMachineCode(0x0f); AddMachineCode(0x87);                         // ja OVERFLOW
@@ -1234,9 +1384,11 @@ long JitAmd64::EmitNewObjectInline(StackClass* cls) {
   const long jne_pos = code_index; AddImm(0);
   { int off = (int)(retry_index - (jne_pos + 4)); memcpy(&code[(size_t)jne_pos], &off, 4); }
 
-  move_imm_reg((int64_t)MemoryManager::YoungRegionAddr(), RDX);
+  move_addr_reg((size_t)MemoryManager::YoungRegionAddr(), RDX);
   move_mem_reg(0, RDX, RDX);                          // RDX = young_region base
   add_reg_reg(RAX, RDX);                              // RDX = raw_mem = base + offset
+#endif
+
   // zero-on-alloc: clear raw_mem[3] (MARKED_FLAG) + field words raw_mem[4..]. raw_mem[0..2]
   // (size word, TYPE, SIZE_OR_CLS) are written explicitly just below, so skip them. Uses
   // only RAX (=0) and RDX (base), both already spilled to TMP_REG_* at entry.
@@ -1246,7 +1398,7 @@ long JitAmd64::EmitNewObjectInline(StackClass* cls) {
   }
   move_imm_reg((int64_t)alloc_size, RAX); move_reg_mem(RAX, 0, RDX);
   move_imm_reg(nil_type, RAX);            move_reg_mem(RAX, (long)sizeof(size_t), RDX);
-  move_imm_reg((int64_t)(size_t)cls, RAX); move_reg_mem(RAX, (long)(sizeof(size_t) * 2), RDX);
+  move_cls_reg(cls, RAX); move_reg_mem(RAX, (long)(sizeof(size_t) * 2), RDX);
   add_imm_reg((int64_t)(sizeof(size_t) * (EXTRA_BUF_SIZE + 1)), RDX);  // RDX = result ptr
 
   move_mem_reg(OP_STACK, RBP, RAX);                   // RAX = op_stack base
@@ -1263,10 +1415,16 @@ long JitAmd64::EmitNewObjectInline(StackClass* cls) {
 
   // allocation_size += size (match AllocateObject — drives the major-GC trigger;
   // skipping it starves GC -> old-gen bloat -> O(n^2) collection time).
-  move_imm_reg((int64_t)MemoryManager::AllocationSizeAddr(), RAX);
+#ifdef _TLAB_JIT_INLINE
+  // Per-thread count, folded into allocation_size when the TLAB retires.
+  AddMachineCode(0x64); AddMachineCode(0x48); AddMachineCode(0x81); AddMachineCode(0x04);
+  AddMachineCode(0x25); AddImm(tlab_off + 16); AddImm((int)size);    // add qword fs:[tlab.allocated], size
+#else
+  move_addr_reg((size_t)MemoryManager::AllocationSizeAddr(), RAX);
   // lock add qword [rax], size -- allocation_size is std::atomic (H3); the bare add
   // raced the locked old-gen updates and lost increments, skewing the major-GC trigger.
   AddMachineCode(0xF0); AddMachineCode(0x48); AddMachineCode(0x81); AddMachineCode(0x00); AddImm((int)size);
+#endif
 
   move_mem_reg(TMP_REG_0, RBP, RAX);
   move_mem_reg(TMP_REG_1, RBP, RBX);
@@ -1294,11 +1452,11 @@ void JitAmd64::EmitJitSafePoint() {
   // Slow path: a collection is active — park.
 #ifdef _WIN64
   sub_imm_reg(32, RSP);   // shadow space (RSP stays 16-aligned)
-  move_imm_reg((size_t)MemoryManager::SafePoint, R10);
+  move_addr_reg((size_t)MemoryManager::SafePoint, R10);
   call_reg(R10);
   add_imm_reg(32, RSP);
 #else
-  move_imm_reg((size_t)MemoryManager::SafePoint, R15);
+  move_addr_reg((size_t)MemoryManager::SafePoint, R15);
   call_reg(R15);
 #endif
   // Backpatch the je to land here, past the slow-path call.
@@ -1742,7 +1900,7 @@ void JitAmd64::EmitWriteBarrier(Register holder) {
   push_reg(RAX); push_reg(RCX); push_reg(RDX); push_reg(R9);   // R9: alignment pad
   move_reg_reg(holder, RCX);                                   // arg0 = holder (MS x64)
   sub_imm_reg(32, RSP);                                        // shadow space
-  move_imm_reg((size_t)MemoryManager::JitWriteBarrier, R10);
+  move_addr_reg((size_t)MemoryManager::JitWriteBarrier, R10);
   call_reg(R10);
   add_imm_reg(32, RSP);
   pop_reg(R9); pop_reg(RDX); pop_reg(RCX); pop_reg(RAX);
@@ -1750,7 +1908,7 @@ void JitAmd64::EmitWriteBarrier(Register holder) {
   push_reg(RAX); push_reg(RCX); push_reg(RDX);
   push_reg(R8);  push_reg(R10); push_reg(R11);
   move_reg_reg(holder, RDI);                                   // arg0 = holder (System V)
-  move_imm_reg((size_t)MemoryManager::JitWriteBarrier, R11);
+  move_addr_reg((size_t)MemoryManager::JitWriteBarrier, R11);
   call_reg(R11);
   pop_reg(R11); pop_reg(R10); pop_reg(R8);
   pop_reg(RDX); pop_reg(RCX); pop_reg(RAX);
@@ -2120,7 +2278,7 @@ void JitAmd64::ProcessStackCallback(long instr_id, StackInstr* instr, long &inst
 #ifdef _WIN64
   // set parameters
   move_imm_reg(instr_id, RCX);
-  move_imm_reg((size_t)instr, RDX);
+  move_instr_reg(instr, RDX);
   move_mem_reg(CLS_ID, RBP, R8);
   move_mem_reg(MTHD_ID, RBP, R9);
   push_imm(instr_index - 1);
@@ -2132,7 +2290,7 @@ void JitAmd64::ProcessStackCallback(long instr_id, StackInstr* instr, long &inst
 
   // call function
   sub_imm_reg(32, RSP);
-  move_imm_reg((size_t)JitCompiler::JitStackCallback, R10);
+  move_addr_reg((size_t)JitCompiler::JitStackCallback, R10);
   call_reg(R10);
   add_imm_reg(80, RSP);
 #else
@@ -2147,7 +2305,7 @@ void JitAmd64::ProcessStackCallback(long instr_id, StackInstr* instr, long &inst
   move_mem_reg(INSTANCE_MEM, RBP, R8);
   move_mem_reg(MTHD_ID, RBP, RCX);
   move_mem_reg(CLS_ID, RBP, RDX);
-  move_imm_reg((size_t)instr, RSI);
+  move_instr_reg(instr, RSI);
   move_imm_reg(instr_id, RDI);  
   push_imm(instr_index - 1);
   push_mem(CALL_STACK_POS, RBP);
@@ -2155,7 +2313,7 @@ void JitAmd64::ProcessStackCallback(long instr_id, StackInstr* instr, long &inst
   push_mem(STACK_POS, RBP);
   
   // call function
-  move_imm_reg((size_t)JitCompiler::JitStackCallback, R15);
+  move_addr_reg((size_t)JitCompiler::JitStackCallback, R15);
   call_reg(R15);
   add_imm_reg(32, RSP);
   
@@ -3164,13 +3322,72 @@ void JitAmd64::move_imm_xreg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64  
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());  
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());  
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif  
   move_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
 }
+
+void JitAmd64::move_addr_reg(size_t addr, Register reg) {
+  const size_t floats = (size_t)float_consts;
+  if(addr >= floats && addr < floats + sizeof(double) * MAX_DBLS) {
+    move_reloc_reg(addr, JIT_RELOC_FLOAT, (long)(addr - floats), nullptr, reg);
+  }
+  else {
+    move_reloc_reg(addr, JIT_RELOC_RUNTIME, JitCodeCache::GetSymbol(addr), nullptr, reg);
+  }
+}
+
+void JitAmd64::move_cls_reg(StackClass* cls, Register reg) {
+  move_reloc_reg((size_t)cls, JIT_RELOC_CLASS, cls->GetId(), nullptr, reg);
+}
+
+void JitAmd64::move_instr_reg(StackInstr* instr, Register reg) {
+  // the instruction belongs to this method or, while inlining, to the callee
+  StackMethod* owners[] = { method, inline_callee };
+  for(StackMethod* owner : owners) {
+    if(owner) {
+      for(long i = 0; i < owner->GetInstructionCount(); ++i) {
+        if(owner->GetInstruction(i) == instr) {
+          move_reloc_reg((size_t)instr, JIT_RELOC_INSTR, i, owner, reg);
+          return;
+        }
+      }
+    }
+  }
+  move_reloc_reg((size_t)instr, JIT_RELOC_INSTR, -1, nullptr, reg);
+}
+
+// Absolute addresses always take the full 64-bit immediate so a cached copy can
+// be patched in place; 'value' < 0 means the address can't be described.
+void JitAmd64::move_reloc_reg(size_t addr, JitRelocType type, long value, StackMethod* owner, Register reg) {
+#ifdef _DEBUG_JIT
+  std::wcout << L"  " << (++instr_count) << L": [movsq $" << (int64_t)addr << L", %"
+        << GetRegisterName(reg) << L"] (reloc)" << std::endl;
+#endif
+  // encode
+  AddMachineCode(XB(reg));
+  unsigned char code = 0xb8;
+  RegisterEncode3(code, 5, reg);
+  AddMachineCode(code);
+  // record value position
+  if(value < 0) {
+    is_relocatable = false;
+  }
+  else {
+    JitReloc reloc;
+    reloc.site = code_index;
+    reloc.type = type;
+    reloc.value = (int32_t)value;
+    reloc.cls_id = owner ? (int32_t)owner->GetClass()->GetId() : -1;
+    reloc.mthd_id = owner ? (int32_t)owner->GetId() : -1;
+    relocs.push_back(reloc);
+  }
+  // write value
+  AddImm64((int64_t)addr);
+}
     
 void JitAmd64::move_mem_xreg(long offset, Register src, Register dest) {
 #ifdef _DEBUG_JIT
@@ -3431,7 +3648,7 @@ RegisterHolder* JitAmd64::call_xfunc(double(*func_ptr)(double), RegInstr* left)
   sub_imm_reg(32, RSP);
 #endif
   RegisterHolder* call_holder = GetRegister();
-  move_imm_reg((size_t)func_ptr, call_holder->GetRegister());
+  move_addr_reg((size_t)func_ptr, call_holder->GetRegister());
   call_reg(call_holder->GetRegister());
   ReleaseRegister(call_holder);
 #ifdef _WIN64
@@ -3485,7 +3702,7 @@ RegisterHolder* JitAmd64::call_xfunc2(double(*func_ptr)(double, double), RegInst
   sub_imm_reg(32, RSP);
 #endif
   RegisterHolder* call_holder = GetRegister();
-  move_imm_reg((size_t)func_ptr, call_holder->GetRegister());
+  move_addr_reg((size_t)func_ptr, call_holder->GetRegister());
   call_reg(call_holder->GetRegister());
   ReleaseRegister(call_holder);
 #ifdef _WIN64
@@ -4015,9 +4232,9 @@ void JitAmd64::add_imm_xreg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif
   add_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
@@ -4027,9 +4244,9 @@ void JitAmd64::sub_imm_xreg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif
   sub_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
@@ -4039,9 +4256,9 @@ void JitAmd64::div_imm_xreg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif
   div_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
@@ -4051,9 +4268,9 @@ void JitAmd64::mul_imm_xreg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif
   mul_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
@@ -4935,7 +5152,7 @@ void JitAmd64::cmp_mem_xreg(long offset, Register src, Register dest) {
 void JitAmd64::cmp_imm_xreg(size_t addr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
-  move_imm_reg(addr, imm_holder->GetRegister());
+  move_addr_reg(addr, imm_holder->GetRegister());
   cmp_mem_xreg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
 }
@@ -4961,9 +5178,9 @@ void JitAmd64::cvt_imm_reg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
 #ifdef _WIN64
-  move_imm_reg(instr->GetOperand2(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand2(), imm_holder->GetRegister());
 #else
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
 #endif
   cvt_mem_reg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
@@ -5796,6 +6013,7 @@ void JitAmd64::ProcessIndices()
           index -= sizeof(double);
           break;
         }
+        osr_locals.push_back({id, index, instr->GetType() == LOAD_FUNC_VAR || instr->GetType() == STOR_FUNC_VAR});
       }
       instr->SetOperand3(index);
       last_id = id;
@@ -6186,6 +6404,10 @@ bool JitAmd64::Compile(StackMethod* cm)
     // Pre-scan: reject methods with unsupported instructions, detect loops
     detected_loops.clear();
     safepoint_lbl_indices.clear();
+    osr_locals.clear();
+    osr_entries.clear();
+    relocs.clear();
+    is_relocatable = true;
     is_inlining = false;
     inline_callee = nullptr;
     inline_local_offset = 0;
@@ -6319,22 +6541,11 @@ bool JitAmd64::Compile(StackMethod* cm)
     local_space += extra_inline_space;
 
     // setup
+    const long frame_space = local_space;
     Prolog();
 
     // method information
-#ifdef _WIN64    
-    move_reg_mem(RCX, CLS_ID, RBP);
-    move_reg_mem(RDX, MTHD_ID, RBP);
-    move_reg_mem(R8, CLASS_MEM, RBP);
-    move_reg_mem(R9, INSTANCE_MEM, RBP);
-#else
-    move_reg_mem(RDI, CLS_ID, RBP);
-    move_reg_mem(RSI, MTHD_ID, RBP);
-    move_reg_mem(RDX, CLASS_MEM, RBP);
-    move_reg_mem(RCX, INSTANCE_MEM, RBP);
-    move_reg_mem(R8, OP_STACK, RBP);
-    move_reg_mem(R9, STACK_POS, RBP);
-#endif
+    SaveArguments();
 
     // register root
     RegisterRoot();
@@ -6373,6 +6584,9 @@ bool JitAmd64::Compile(StackMethod* cm)
       return false;
     }
 
+    // loop-header entries for on-stack replacement
+    EmitOsrEntries(frame_space);
+
     // show content
     std::unordered_map<long, StackInstr*>::iterator iter;
     for(iter = jump_table.begin(); iter != jump_table.end(); ++iter) {
@@ -6415,8 +6629,24 @@ bool JitAmd64::Compile(StackMethod* cm)
     std::wcout << L"Caching JIT code: actual=" << code_index
       << L", buffer=" << code_buf_max << L" byte(s)" << std::endl;
 #endif
+    // keep a copy for the next run
+    if(is_relocatable && JitCodeCache::IsEnabled()) {
+      JitCacheEntry entry;
+      entry.cls_id = method->GetClass()->GetId();
+      entry.mthd_id = method->GetId();
+      entry.code.assign(code, code + code_index);
+      entry.floats.assign(float_consts, float_consts + floats_index);
+      entry.relocs = relocs;
+      entry.osr_entries = osr_entries;
+      JitCodeCache::Store(entry);
+    }
+
     // store compiled code
-    method->SetNativeCode(new NativeCode(page_manager->GetPage(code, code_index), code_index, float_consts));
+    NativeCode* native_code = new NativeCode(page_manager->GetPage(code, code_index), code_index, float_consts);
+    for(size_t i = 0; i < osr_entries.size(); ++i) {
+      native_code->AddOsrEntry(osr_entries[i].first, osr_entries[i].second);
+    }
+    method->SetNativeCode(native_code);
 
     free(code);
     code = nullptr;
@@ -6443,7 +6673,7 @@ void JitRuntime::Initialize(StackProgram* p)
 }
 
 // Executes machine code
-long JitRuntime::Execute(StackMethod* method, size_t* inst, size_t* op_stack, size_t* stack_pos, StackFrame** call_stack, long* call_stack_pos, StackFrame* frame) 
+long JitRuntime::Execute(StackMethod* method, size_t* inst, size_t* op_stack, size_t* stack_pos, StackFrame** call_stack, long* call_stack_pos, StackFrame* frame, long entry) 
 {
   const long cls_id = method->GetClass()->GetId();
   const long mthd_id = method->GetId();
@@ -6454,11 +6684,11 @@ long JitRuntime::Execute(StackMethod* method, size_t* inst, size_t* op_stack, si
         << L"'; self=" << inst << L"(" << (size_t)inst << L"); std::stack=" << op_stack << L"; stack_pos="
         << (*stack_pos) << L"; params=" << method->GetParamCount() << L"; code=" << (size_t*)native_code->GetCode() << L"; code_index="
         << native_code->GetSize() << L" ===" << std::endl;
-  assert((*stack_pos) >= method->GetParamCount());
+  assert(entry > 0 || (*stack_pos) >= method->GetParamCount());
 #endif
 
   // create function
-  jit_fun_ptr jit_fun = (jit_fun_ptr)native_code->GetCode();
+  jit_fun_ptr jit_fun = (jit_fun_ptr)(native_code->GetCode() + entry);
 
   // execute
   const long status = jit_fun(cls_id, mthd_id, method->GetClass()->GetClassMemory(), inst, op_stack,
@@ -357,6 +357,22 @@ namespace Runtime {
     // labels need a GC safepoint poll — if/else merge labels are skipped.
     std::unordered_set<long> safepoint_lbl_indices;
 
+    // on-stack replacement: the native slot of each interpreter local (frame
+    // memory word id + 1; a function reference spans two words) and the code
+    // offset of each loop header's entry stub
+    struct OsrLocal {
+      long id;
+      long offset;
+      bool is_func;
+    };
+    std::vector<OsrLocal> osr_locals;
+    std::vector<std::pair<long, long>> osr_entries;
+
+    // code cache: absolute addresses emitted so far; cleared if one can't be
+    // described, in which case the method is not cached
+    std::vector<JitReloc> relocs;
+    bool is_relocatable;
+
     // local variable register cache: keeps registers live after store
     // to avoid redundant reloads. Evicted on demand when pool is empty.
     std::unordered_map<long, RegisterHolder*> local_reg_cache;
@@ -374,6 +390,8 @@ namespace Runtime {
     // setup and tear down
     void Prolog();
     void Epilog();
+    void SaveArguments();
+    void EmitOsrEntries(long frame_space);
 
     // stack conversion operations
     void ProcessParameters(long count);
@@ -922,6 +940,10 @@ namespace Runtime {
     void move_imm_reg(long imm, Register reg);
 #endif  
     void move_imm_xreg(RegInstr* instr, Register reg);
+    void move_addr_reg(size_t addr, Register reg);
+    void move_cls_reg(StackClass* cls, Register reg);
+    void move_instr_reg(StackInstr* instr, Register reg);
+    void move_reloc_reg(size_t addr, JitRelocType type, long value, StackMethod* owner, Register reg);
     void move_mem_xreg(long offset, Register src, Register dest);
     void move_xreg_mem(Register src, long offset, Register dest);
     void move_xreg_xreg(Register src, Register dest);
@@ -1051,6 +1073,7 @@ namespace Runtime {
 
   public:
     static void Initialize(StackProgram* p);
+    static void InstallCachedCode();
 
     JitAmd64() {
     }
@@ -1136,8 +1159,9 @@ namespace Runtime {
   public:
     static void Initialize(StackProgram* p);
 
-    // Executes machine code
+    // Executes machine code; a non-zero 'entry' is an on-stack replacement
+    // entry that resumes the interpreted call held in 'frame'
     long Execute(StackMethod* method, size_t* inst, size_t* op_stack, size_t* stack_pos, 
-                 StackFrame** call_stack, long* call_stack_pos, StackFrame* frame);
+                 StackFrame** call_stack, long* call_stack_pos, StackFrame* frame, long entry = 0);
   };
 }
@@ -42,6 +42,69 @@ PageManager* JitArm64::page_manager;
 void JitArm64::Initialize(StackProgram* p) {
   JitCompiler::Initialize(p);
   page_manager = new PageManager;
+  InstallCachedCode();
+}
+
+const char* JitCodeCache::GetStamp() {
+  return "arm64 " __DATE__ " " __TIME__;
+}
+
+// Installs methods compiled by an earlier run (JitCodeCache::Open) before any
+// code runs: pool slots holding addresses are resolved against this process and
+// call sites are patched, so these methods are native from their first call.
+void JitArm64::InstallCachedCode() {
+  JitCacheEntry entry;
+  while(JitCodeCache::Next(entry)) {
+    StackMethod* mthd = program->GetClass(entry.cls_id)->GetMethod(entry.mthd_id);
+    if(!mthd || mthd->GetNativeCode()) {
+      continue;
+    }
+
+    // constant pools
+    int64_t* ints = new int64_t[MAX_INTS];
+    double* floats = new double[MAX_DBLS];
+    bool resolved = entry.code.size() % sizeof(uint32_t) == 0 &&
+      entry.ints.size() <= MAX_INTS && entry.floats.size() <= MAX_DBLS;
+    for(size_t i = 0; resolved && i < entry.ints.size(); ++i) {
+      ints[i] = entry.ints[i];
+    }
+    floats[0] = 0.0;
+    for(size_t i = 0; resolved && i < entry.floats.size(); ++i) {
+      floats[i] = entry.floats[i];
+    }
+
+    // relocations
+    const long float_count = entry.floats.empty() ? 1 : (long)entry.floats.size();
+    for(size_t i = 0; resolved && i < entry.relocs.size(); ++i) {
+      const JitReloc &reloc = entry.relocs[i];
+      const size_t addr = JitCodeCache::Resolve(program, reloc, floats, float_count);
+      if(!addr || reloc.site < 0 || reloc.site >= (int64_t)entry.ints.size()) {
+        resolved = false;
+      }
+      else {
+        ints[reloc.site] = (int64_t)addr;
+      }
+    }
+
+    if(!resolved || !mthd->ClaimJitCompile()) {
+      delete[] ints;
+      delete[] floats;
+      if(!resolved) {
+        JitCodeCache::Reject(entry);
+      }
+      continue;
+    }
+
+    const long code_size = (long)(entry.code.size() / sizeof(uint32_t));
+    NativeCode* native_code = new NativeCode(page_manager->GetPage((uint32_t*)entry.code.data(), code_size), code_size, ints, floats);
+    for(size_t i = 0; i < entry.osr_entries.size(); ++i) {
+      native_code->AddOsrEntry(entry.osr_entries[i].first, entry.osr_entries[i].second);
+    }
+    mthd->SetNativeCode(native_code);
+    PatchCallSites(mthd, 1);
+    mthd->SetJitDone();
+    JitCodeCache::Installed();
+  }
 }
 
 // setup of stack frame
@@ -99,7 +162,7 @@ void JitArm64::Prolog() {
   // pointer anyway) is never scanned or clobbered.
   const long stw_save_off = final_local_space - (long)sizeof(size_t);
   move_reg_mem(X19, stw_save_off, SP);                              // str x19, [sp, #stw_save_off]
-  move_imm_reg((size_t)MemoryManager::StwActiveAddr(), X19);         // X19 = &stw_active
+  move_addr_reg((size_t)MemoryManager::StwActiveAddr(), X19);         // X19 = &stw_active
 }
 
 // tear down of stack frame
@@ -171,6 +234,50 @@ void JitArm64::Epilog() {
   }
 }
 
+// On-stack replacement entries, one per loop header. Each stub builds the same
+// frame as the method entry but, in place of popping parameters, loads every
+// local from the interpreter frame and branches to the loop label. The frame
+// memory is reached through &frame->jit_mem (JIT_MEM), as in the callback
+// INSTANCE_MEM refresh. At a label the working stack is empty and no local is
+// cached in a register, so the stack slots are the whole state the loop needs.
+void JitArm64::EmitOsrEntries(long frame_space) {
+  const long mem_delta = (long)(offsetof(StackFrame, jit_mem) - offsetof(StackFrame, mem));
+  for(unordered_set<long>::iterator iter = safepoint_lbl_indices.begin(); iter != safepoint_lbl_indices.end(); ++iter) {
+    const long lbl_index = *iter;
+#ifdef _DEBUG_JIT_JIT
+    std::wcout << L"  " << (++instr_count) << L": [<osr entry: lbl=" << lbl_index << L">]" << std::endl;
+#endif
+    // the interpreter looks entries up by JMP operand (label index + 1)
+    osr_entries.push_back(pair<long, long>(lbl_index + 1, code_index));
+
+    local_space = frame_space;
+    Prolog();
+    RegisterRoot();
+
+    RegisterHolder* mem_holder = GetRegister();
+    RegisterHolder* value_holder = GetRegister();
+    move_mem_reg(JIT_MEM, SP, mem_holder->GetRegister());                  // &frame->jit_mem
+    sub_imm_reg(mem_delta, mem_holder->GetRegister());                      // &frame->mem
+    move_mem_reg(0, mem_holder->GetRegister(), mem_holder->GetRegister());  // frame->mem
+    for(size_t i = 0; i < osr_locals.size(); ++i) {
+      const OsrLocal& local = osr_locals[i];
+      const long words = local.is_func ? 2 : 1;
+      for(long j = 0; j < words; ++j) {
+        move_mem_reg((local.id + 1 + j) * sizeof(size_t), mem_holder->GetRegister(), value_holder->GetRegister());
+        move_reg_mem(value_holder->GetRegister(), local.offset + j * sizeof(size_t), SP);
+      }
+    }
+    ReleaseRegister(value_holder);
+    ReleaseRegister(mem_holder);
+
+    // b to the loop label
+    const long lbl_offset = method->GetInstruction(lbl_index)->GetOffset();
+    uint32_t op_code = B_INSTR;
+    op_code |= (lbl_offset - code_index) & 0x03ffffff;
+    AddMachineCode(op_code);
+  }
+}
+
 // register with memory manager
 void JitArm64::RegisterRoot() {
   const size_t mem_offset = RED_ZONE + sizeof(size_t);
@@ -1530,7 +1637,7 @@ void JitArm64::EmitWriteBarrier(Register holder) {
   if(holder != X0) {
     move_reg_reg(holder, X0);            // arg0 = holder (AAPCS64)
   }
-  move_imm_reg((size_t)MemoryManager::JitWriteBarrier, X10);
+  move_addr_reg((size_t)MemoryManager::JitWriteBarrier, X10);
   call_reg(X10);
   move_mem_reg(TMP_X0, SP, holder);      // restore destination object
   for(size_t i = 0; i < spilled_ws.size(); ++i) {
@@ -1904,10 +2011,10 @@ void JitArm64::ProcessStackCallback(long instr_id, StackInstr* instr, long &inst
   move_mem_reg(INSTANCE_MEM, SP, X4);
   move_mem_reg(MTHD_ID, SP, X3);
   move_mem_reg(CLS_ID, SP, X2);
-  move_imm_reg((size_t)instr, X1);
+  move_instr_reg(instr, X1);
   move_imm_reg(instr_id, X0);
   
-  move_imm_reg((size_t)JitArm64::JitStackCallback, X10);
+  move_addr_reg((size_t)JitArm64::JitStackCallback, X10);
   call_reg(X10);
   
   // restore register values
@@ -1966,7 +2073,7 @@ void JitArm64::EmitJitSafePoint() {
   const long cbz_index = code_index;
   cbz_reg(X11);                                                       // cbz W11, skip (patched below)
   // Slow path: a collection is active — park.
-  move_imm_reg((size_t)MemoryManager::SafePoint, X10);
+  move_addr_reg((size_t)MemoryManager::SafePoint, X10);
   call_reg(X10);
   // Backpatch the cbz imm19 (bits 23:5, offset in instructions) to land past the call.
   const long skip_index = code_index;
@@ -2644,6 +2751,48 @@ void JitArm64::move_imm_reg32(int32_t imm, Register reg) {
   move_imm_reg(imm, reg);
 }
 
+void JitArm64::move_addr_reg(size_t addr, Register reg) {
+  const size_t floats = (size_t)float_consts;
+  if(addr >= floats && addr < floats + sizeof(double) * MAX_DBLS) {
+    move_reloc_reg(addr, JIT_RELOC_FLOAT, (long)(addr - floats), nullptr, reg);
+  }
+  else {
+    move_reloc_reg(addr, JIT_RELOC_RUNTIME, JitCodeCache::GetSymbol(addr), nullptr, reg);
+  }
+}
+
+void JitArm64::move_instr_reg(StackInstr* instr, Register reg) {
+  for(long i = 0; i < method->GetInstructionCount(); ++i) {
+    if(method->GetInstruction(i) == instr) {
+      move_reloc_reg((size_t)instr, JIT_RELOC_INSTR, i, method, reg);
+      return;
+    }
+  }
+  move_reloc_reg((size_t)instr, JIT_RELOC_INSTR, -1, nullptr, reg);
+}
+
+// Absolute addresses always load from the int pool (never MOVZ/MOVK) so a cached
+// copy can be re-pointed by patching its pool slot; 'value' < 0 means the
+// address can't be described.
+void JitArm64::move_reloc_reg(size_t addr, JitRelocType type, long value, StackMethod* owner, Register reg) {
+  if(value < 0) {
+    is_relocatable = false;
+  }
+  else {
+    JitReloc reloc;
+    reloc.site = -1;
+    reloc.type = type;
+    reloc.value = (int32_t)value;
+    reloc.cls_id = owner ? (int32_t)owner->GetClass()->GetId() : -1;
+    reloc.mthd_id = owner ? (int32_t)owner->GetId() : -1;
+    reloc_consts[addr] = reloc;
+  }
+
+  move_mem_reg(INT_CONSTS, SP, X9);
+  move_mem_reg(0, X9, reg);
+  const_int_pool.insert(pair<size_t, size_t>(addr, code_index - 1));
+}
+
 void JitArm64::add_reg_reg(Register src, Register dest) {
 #ifdef _DEBUG_JIT_JIT
   std::wcout << L"  " << (++instr_count) << L": [add " << GetRegisterName(dest)
@@ -3346,7 +3495,7 @@ void JitArm64::move_imm_memf(RegInstr* instr, long offset, Register dest) {
 void JitArm64::move_imm_freg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
   move_mem_freg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
 }
@@ -3512,7 +3661,7 @@ void JitArm64::sqrt_freg_freg(Register src, Register dest) {
 void JitArm64::vcvt_imm_reg(RegInstr* instr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
-  move_imm_reg(instr->GetOperand(), imm_holder->GetRegister());
+  move_addr_reg((size_t)instr->GetOperand(), imm_holder->GetRegister());
   vcvt_mem_reg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
 }
@@ -3663,7 +3812,7 @@ void JitArm64::cmp_mem_freg(long offset, Register src, Register dest) {
 void JitArm64::cmp_imm_freg(size_t addr, Register reg) {
   // copy address of imm value
   RegisterHolder* imm_holder = GetRegister();
-  move_imm_reg(addr, imm_holder->GetRegister());
+  move_addr_reg(addr, imm_holder->GetRegister());
   cmp_mem_freg(0, imm_holder->GetRegister(), reg);
   ReleaseRegister(imm_holder);
 }
@@ -4315,7 +4464,7 @@ void JitArm64::ProcessFloatOperation(StackInstr* instruction)
   
   // call function
   move_reg_mem(X9, TMP_X0, SP);
-  move_imm_reg((size_t)func_ptr, X9);
+  move_addr_reg((size_t)func_ptr, X9);
   call_reg(X9);
   move_mem_reg(TMP_X0, SP, X9);
 
@@ -4498,7 +4647,7 @@ void JitArm64::ProcessFloatOperation2(StackInstr* instruction)
   
   // call function
   move_reg_mem(X9, TMP_X0, SP);
-  move_imm_reg((size_t)func_ptr, X9);
+  move_addr_reg((size_t)func_ptr, X9);
   call_reg(X9);
   move_mem_reg(TMP_X0, SP, X9);
   
@@ -4854,6 +5003,7 @@ void JitArm64::ProcessIndices()
         else {
           index += sizeof(double);
         }
+        osr_locals.push_back({id, index, instr->GetType() == LOAD_FUNC_VAR || instr->GetType() == STOR_FUNC_VAR});
       }
       instr->SetOperand3(index);
       last_id = id;
@@ -5053,6 +5203,11 @@ bool JitArm64::Compile(StackMethod* cm)
     // + direct JIT-to-JIT calling. STOR_INT_ARY_ELM is safe — integer array
     // stores don't hold references.
     safepoint_lbl_indices.clear();
+    osr_locals.clear();
+    osr_entries.clear();
+    reloc_consts.clear();
+    relocs.clear();
+    is_relocatable = true;
     for(long i = 0; i < method->GetInstructionCount(); ++i) {
       StackInstr* scan_instr = method->GetInstruction(i);
       if(!CanJitInstruction(scan_instr->GetType())) {
@@ -5154,6 +5309,7 @@ bool JitArm64::Compile(StackMethod* cm)
     ProcessIndices();
     
     // setup
+    const long frame_space = local_space;
     Prolog();
     
     // register root
@@ -5180,6 +5336,9 @@ bool JitArm64::Compile(StackMethod* cm)
 
       return false;
     }
+
+    // loop-header entries for on-stack replacement
+    EmitOsrEntries(frame_space);
     
     // update jump addresses
     unordered_map<long, StackInstr*>::iterator jmp_iter;
@@ -5275,6 +5434,12 @@ bool JitArm64::Compile(StackMethod* cm)
       else {
         code[src_offset] |= ints_index << 10;
         int_pool_cache.insert(pair<size_t, size_t>(const_value, ints_index));
+        unordered_map<size_t, JitReloc>::iterator reloc_found = reloc_consts.find(const_value);
+        if(reloc_found != reloc_consts.end()) {
+          JitReloc reloc = reloc_found->second;
+          reloc.site = ints_index;
+          relocs.push_back(reloc);
+        }
         ints[ints_index++] = const_value;
       }
     }
@@ -5286,8 +5451,25 @@ bool JitArm64::Compile(StackMethod* cm)
     std::wcout << L"Caching JIT code: actual=" << code_index << L", buffer=" << code_buf_max << L" byte(s)" << std::endl;
 #endif
     
+    // keep a copy for the next run
+    if(is_relocatable && JitCodeCache::IsEnabled()) {
+      JitCacheEntry entry;
+      entry.cls_id = method->GetClass()->GetId();
+      entry.mthd_id = method->GetId();
+      entry.code.assign((unsigned char*)code, (unsigned char*)(code + code_index));
+      entry.floats.assign(float_consts, float_consts + floats_index);
+      entry.ints.assign(ints, ints + ints_index);
+      entry.relocs = relocs;
+      entry.osr_entries = osr_entries;
+      JitCodeCache::Store(entry);
+    }
+
     // store compiled code
-    method->SetNativeCode(new NativeCode(page_manager->GetPage(code, static_cast<int>(code_index)), code_index, ints, float_consts));
+    NativeCode* native_code = new NativeCode(page_manager->GetPage(code, static_cast<int>(code_index)), code_index, ints, float_consts);
+    for(size_t i = 0; i < osr_entries.size(); ++i) {
+      native_code->AddOsrEntry(osr_entries[i].first, osr_entries[i].second);
+    }
+    method->SetNativeCode(native_code);
     
     free(code);
     code = nullptr;
@@ -5310,7 +5492,7 @@ void JitRuntime::Initialize(StackProgram* p)
 
 // Executes machine code
 long JitRuntime::Execute(StackMethod* method, size_t* inst, size_t* op_stack, size_t* stack_pos,
-                          StackFrame** call_stack, long* call_stack_pos, StackFrame* frame)
+                          StackFrame** call_stack, long* call_stack_pos, StackFrame* frame, long entry)
 {
   const int32_t cls_id = static_cast<int>(method->GetClass()->GetId());
   const int32_t mthd_id = static_cast<int>(method->GetId());
@@ -5323,11 +5505,11 @@ long JitRuntime::Execute(StackMethod* method, size_t* inst, size_t* op_stack, si
         << L"'; self=" << inst << L"(" << (size_t)inst << L"); stack=" << op_stack << L"; stack_pos="
         << (*stack_pos) << L"; params=" << method->GetParamCount() << L"; code=" << (size_t *)native_code->GetCode() << L"; code_index="
         << code_size << L" ===" << std::endl;
-  assert((*stack_pos) >= method->GetParamCount());
+  assert(entry > 0 || (*stack_pos) >= method->GetParamCount());
 #endif
   
   // create function
-  uint32_t* code = native_code->GetCode();
+  uint32_t* code = native_code->GetCode() + entry;
   jit_fun_ptr jit_fun = (jit_fun_ptr)code;
   
   // execute
@@ -378,6 +378,24 @@ namespace Runtime {
     // instruction indices of loop-header labels (back-edge targets); only these
     // labels need a GC safepoint poll — if/else merge labels are skipped.
     unordered_set<long> safepoint_lbl_indices;
+
+    // on-stack replacement: the native slot of each interpreter local (frame
+    // memory word id + 1; a function reference spans two words) and the code
+    // offset of each loop header's entry stub, keyed by the JMP operand
+    struct OsrLocal {
+      long id;
+      long offset;
+      bool is_func;
+    };
+    vector<OsrLocal> osr_locals;
+    vector<pair<long, long>> osr_entries;
+
+    // code cache: absolute addresses loaded from the int pool, by value; cleared
+    // if one can't be described, in which case the method is not cached
+    unordered_map<size_t, JitReloc> reloc_consts;
+    vector<JitReloc> relocs;
+    bool is_relocatable;
+
     // CBZ/CBNZ optimization: track last comparison
     bool last_cmp_was_zero;
     Register last_cmp_reg;
@@ -390,6 +408,7 @@ namespace Runtime {
     // setup and teardown
     void Prolog();
     void Epilog();
+    void EmitOsrEntries(long frame_space);
 
     // stack conversion operations
     void ProcessParameters(long count);
@@ -697,6 +716,9 @@ namespace Runtime {
     void move_imm_reg(long imm, Register reg);
 #endif
     void move_imm_reg32(int32_t imm, Register reg);
+    void move_addr_reg(size_t addr, Register reg);
+    void move_instr_reg(StackInstr* instr, Register reg);
+    void move_reloc_reg(size_t addr, JitRelocType type, long value, StackMethod* owner, Register reg);
     void move_imm_freg(RegInstr* instr, Register reg);
     void move_mem_freg(long offset, Register src, Register dest);
     void move_freg_mem(Register src, long offset, Register dest);
@@ -816,6 +838,7 @@ namespace Runtime {
 
   public:
     static void Initialize(StackProgram* p);
+    static void InstallCachedCode();
 
     JitArm64() {
     }
@@ -894,8 +917,9 @@ namespace Runtime {
   public:
     static void Initialize(StackProgram* p);
     
-    // Executes machine code
+    // Executes machine code; a non-zero 'entry' is an on-stack replacement
+    // entry that resumes the interpreted call held in 'frame'
     long Execute(StackMethod* method, size_t* inst, size_t* op_stack, size_t* stack_pos,
-                 StackFrame** call_stack, long* call_stack_pos, StackFrame* frame);
+                 StackFrame** call_stack, long* call_stack_pos, StackFrame* frame, long entry = 0);
   };
 }
@@ -30,6 +30,7 @@
  ***************************************************************************/
 
 #include "jit_common.h"
+#include <cmath>
 
 #ifndef _NO_JIT
 #if defined(_M_ARM64)
@@ -43,9 +44,74 @@
 
 StackProgram* JitCompiler::program;
 
+std::priority_queue<JitCompileTask> JitCompiler::compile_queue;
+long JitCompiler::compile_seq;
+bool JitCompiler::compile_thread_started;
+bool JitCompiler::compile_thread_stop;
+#ifdef _WIN32
+CRITICAL_SECTION JitCompiler::compile_lock;
+CONDITION_VARIABLE JitCompiler::compile_cv;
+HANDLE JitCompiler::compile_thread;
+#else
+pthread_mutex_t JitCompiler::compile_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t JitCompiler::compile_cv = PTHREAD_COND_INITIALIZER;
+pthread_t JitCompiler::compile_thread;
+#endif
+
+std::atomic<long> JitCompiler::compiled_count;
+std::atomic<long> JitCompiler::failed_count;
+std::atomic<long> JitCompiler::queue_depth;
+std::atomic<long> JitCompiler::queue_max;
+std::atomic<long> JitCompiler::compile_last_us;
+std::atomic<long> JitCompiler::compile_max_us;
+std::atomic<long> JitCompiler::compile_total_us;
+
+std::string JitCodeCache::cache_file;
+uint64_t JitCodeCache::image_hash;
+uint64_t JitCodeCache::image_size;
+std::map<std::pair<long, long>, std::string> JitCodeCache::records;
+std::vector<std::pair<long, long>> JitCodeCache::pending;
+bool JitCodeCache::dirty;
+#ifdef _WIN32
+CRITICAL_SECTION JitCodeCache::cache_lock;
+#else
+pthread_mutex_t JitCodeCache::cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+size_t JitCodeCache::symbols[JIT_CACHE_MAX_SYMBOLS];
+long JitCodeCache::symbol_count;
+
+std::atomic<long> JitCodeCache::loaded_count;
+std::atomic<long> JitCodeCache::installed_count;
+std::atomic<long> JitCodeCache::stored_count;
+std::atomic<long> JitCodeCache::rejected_count;
+
 void JitCompiler::Initialize(StackProgram* p)
 {
   program = p;
+#ifdef _WIN32
+  InitializeCriticalSection(&compile_lock);
+  InitializeConditionVariable(&compile_cv);
+#endif
+}
+
+void JitCompiler::StopCompileThread()
+{
+  MUTEX_LOCK(&compile_lock);
+  if(!compile_thread_started) {
+    MUTEX_UNLOCK(&compile_lock);
+    return;
+  }
+  compile_thread_stop = true;
+  WAKE_ALL_CONDITION(&compile_cv);
+  MUTEX_UNLOCK(&compile_lock);
+
+#ifdef _WIN32
+  WaitForSingleObject(compile_thread, INFINITE);
+  CloseHandle(compile_thread);
+#else
+  pthread_join(compile_thread, nullptr);
+#endif
+  compile_thread_started = false;
 }
 
 JitCompiler::JitCompiler()
@@ -76,6 +142,10 @@ bool JitCompiler::TryAutoJitCompile(StackMethod* callee)
   if(state == StackMethod::JIT_FAILED) {
     return false;
   }
+  // queued or compiling: skip the claim CAS on this hot path
+  if(state == StackMethod::JIT_COMPILING) {
+    return true;
+  }
   if(!callee->ClaimJitCompile()) {
     // Another thread owns (or just settled) the compile. Re-read the outcome:
     // treat anything but a definitive failure as "will be available" so the
@@ -83,7 +153,20 @@ bool JitCompiler::TryAutoJitCompile(StackMethod* callee)
     return callee->GetJitState() != StackMethod::JIT_FAILED;
   }
 
-  // We own the compile. P2: DYN_MTHD_CALL auto-JIT enabled (func-ref/closure calls).
+  // We own the compile. Hand it to the compiler thread; the claim keeps the
+  // method JIT_COMPILING until the thread publishes the outcome, and callers
+  // interpret (GetNativeCode() is still null) in the meantime.
+  if(GetJitBackground()) {
+    QueueCompile(callee);
+    return true;
+  }
+
+  return CompileClaimed(callee);
+}
+
+bool JitCompiler::CompileClaimed(StackMethod* callee)
+{
+  // P2: DYN_MTHD_CALL auto-JIT enabled (func-ref/closure calls).
 #if defined(_M_ARM64)
   Runtime::JitArm64 jit_compiler;
 #elif defined(_WIN64) || defined(_X64)
@@ -92,21 +175,103 @@ bool JitCompiler::TryAutoJitCompile(StackMethod* callee)
   Runtime::JitArm64 jit_compiler;
 #endif
 
-  if(jit_compiler.Compile(callee)) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const bool compiled = jit_compiler.Compile(callee);
+  const long elapsed_us = (long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  compile_last_us.store(elapsed_us, std::memory_order_relaxed);
+  compile_total_us.fetch_add(elapsed_us, std::memory_order_relaxed);
+  if(elapsed_us > compile_max_us.load(std::memory_order_relaxed)) {
+    compile_max_us.store(elapsed_us, std::memory_order_relaxed);
+  }
+
+  if(compiled) {
     // Compile() published native_code (release). Patch all call sites AFTER that
     // so any thread observing a *_JIT opcode / operand3>0 also sees native_code;
     // the interpreter's JIT paths additionally re-check GetNativeCode() and fall
     // back to interpreting if a patch is observed before the pointer is visible.
     PatchCallSites(callee, 1);
     callee->SetJitDone();
+    compiled_count.fetch_add(1, std::memory_order_relaxed);
     return true;
   }
 
   // Definitive failure: mark so every call site can switch to interpret-only.
   callee->SetJitAttempted();
+  failed_count.fetch_add(1, std::memory_order_relaxed);
   return false;
 }
 
+void JitCompiler::QueueCompile(StackMethod* callee)
+{
+  MUTEX_LOCK(&compile_lock);
+  if(compile_thread_stop) {
+    // shutting down: leave the method interpreted
+    MUTEX_UNLOCK(&compile_lock);
+    callee->SetJitAttempted();
+    return;
+  }
+
+  if(!compile_thread_started) {
+#ifdef _WIN32
+    compile_thread = (HANDLE)_beginthreadex(nullptr, 0, CompileThreadMain, nullptr, 0, nullptr);
+    compile_thread_started = compile_thread != nullptr;
+#else
+    compile_thread_started = pthread_create(&compile_thread, nullptr, CompileThreadMain, nullptr) == 0;
+#endif
+    if(!compile_thread_started) {
+      // no thread: compile here, as in synchronous mode
+      MUTEX_UNLOCK(&compile_lock);
+      CompileClaimed(callee);
+      return;
+    }
+  }
+
+  compile_queue.push({ callee, callee->GetJitCallCount() + callee->GetJitLoopCount(), compile_seq++ });
+  const long depth = (long)compile_queue.size();
+  queue_depth.store(depth, std::memory_order_relaxed);
+  if(depth > queue_max.load(std::memory_order_relaxed)) {
+    queue_max.store(depth, std::memory_order_relaxed);
+  }
+  WAKE_ALL_CONDITION(&compile_cv);
+  MUTEX_UNLOCK(&compile_lock);
+}
+
+#ifdef _WIN32
+unsigned int WINAPI JitCompiler::CompileThreadMain(LPVOID arg)
+#else
+void* JitCompiler::CompileThreadMain(void* arg)
+#endif
+{
+  while(true) {
+    MUTEX_LOCK(&compile_lock);
+    while(!compile_thread_stop && compile_queue.empty()) {
+      SLEEP_CONDITION(&compile_cv, &compile_lock);
+    }
+    if(compile_thread_stop) {
+      // drop the backlog; those methods stay interpreted
+      while(!compile_queue.empty()) {
+        compile_queue.top().method->SetJitAttempted();
+        compile_queue.pop();
+      }
+      queue_depth.store(0, std::memory_order_relaxed);
+      MUTEX_UNLOCK(&compile_lock);
+      break;
+    }
+    StackMethod* callee = compile_queue.top().method;
+    compile_queue.pop();
+    queue_depth.store((long)compile_queue.size(), std::memory_order_relaxed);
+    MUTEX_UNLOCK(&compile_lock);
+
+    CompileClaimed(callee);
+  }
+
+#ifdef _WIN32
+  return 0;
+#else
+  return nullptr;
+#endif
+}
+
 void JitCompiler::PatchCallSites(StackMethod* callee, long patch_value)
 {
   const long target_cls_id = callee->GetClass()->GetId();
@@ -146,6 +311,403 @@ void JitCompiler::PatchCallSites(StackMethod* callee, long patch_value)
     }
   }
 }
+
+/**
+ * Persistent code cache
+ */
+#define JIT_CACHE_MAGIC "OJC1"
+#define JIT_CACHE_FORMAT 1
+#define JIT_CACHE_STAMP_SIZE 64
+
+template<typename T> static void CacheWrite(std::string &out, const T &value)
+{
+  out.append((const char*)&value, sizeof(value));
+}
+
+template<typename T> static bool CacheRead(const char* buffer, size_t size, size_t &pos, T &value)
+{
+  if(pos + sizeof(value) > size) {
+    return false;
+  }
+  memcpy(&value, buffer + pos, sizeof(value));
+  pos += sizeof(value);
+  return true;
+}
+
+void JitCodeCache::InitSymbols()
+{
+  if(symbol_count) {
+    return;
+  }
+
+  // order is part of the file format; the stamp invalidates files from other builds
+  const size_t runtime[] = {
+    (size_t)MemoryManager::StwActiveAddr(),
+    (size_t)MemoryManager::YoungOffsetAddr(),
+    (size_t)MemoryManager::YoungRegionSizeAddr(),
+    (size_t)MemoryManager::YoungRegionAddr(),
+    (size_t)MemoryManager::AllocationSizeAddr(),
+    (size_t)MemoryManager::SafePoint,
+    (size_t)MemoryManager::JitWriteBarrier,
+    (size_t)JitCompiler::JitStackCallback
+  };
+
+  double(*unary[])(double) = {
+    sin, cos, tan, log, log10, trunc, exp, asin, acos, atan, acosh, asinh,
+    atanh, log2, cbrt, cosh, sinh, tanh, tgamma
+  };
+
+  double(*binary[])(double, double) = { atan2, fmod, pow };
+
+  long count = 0;
+  for(size_t i = 0; i < sizeof(runtime) / sizeof(runtime[0]); ++i) {
+    symbols[count++] = runtime[i];
+  }
+  for(size_t i = 0; i < sizeof(unary) / sizeof(unary[0]); ++i) {
+    symbols[count++] = (size_t)unary[i];
+  }
+  for(size_t i = 0; i < sizeof(binary) / sizeof(binary[0]); ++i) {
+    symbols[count++] = (size_t)binary[i];
+  }
+  symbol_count = count;
+}
+
+long JitCodeCache::GetSymbol(size_t addr)
+{
+  // the table is built by Open; without a cache nothing is described
+  if(!IsEnabled()) {
+    return -1;
+  }
+
+  for(long i = 0; i < symbol_count; ++i) {
+    if(symbols[i] == addr) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+void JitCodeCache::Open(StackProgram* program, const char* image, size_t size)
+{
+  const std::string &dir = GetJitCacheDir();
+  if(dir.empty() || !image || !size) {
+    return;
+  }
+
+#ifdef _WIN32
+  InitializeCriticalSection(&cache_lock);
+#endif
+  InitSymbols();
+
+  // key: FNV-1a over the decompressed executable image
+  uint64_t hash = 14695981039346656037ull;
+  for(size_t i = 0; i < size; ++i) {
+    hash ^= (uint8_t)image[i];
+    hash *= 1099511628211ull;
+  }
+  image_hash = hash;
+  image_size = size;
+
+  std::stringstream name;
+  name << dir << '/' << std::hex << std::setw(16) << std::setfill('0') << hash << ".ojc";
+  cache_file = name.str();
+
+  // map the file
+  char* buffer = nullptr;
+  size_t buffer_size = 0;
+#ifdef _WIN32
+  _mkdir(dir.c_str());
+  std::ifstream in(cache_file.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+  if(!in.good()) {
+    return;
+  }
+  buffer_size = (size_t)in.tellg();
+  in.seekg(0, std::ios::beg);
+  buffer = (char*)malloc(buffer_size + 1);
+  in.read(buffer, buffer_size);
+  in.close();
+#else
+  mkdir(dir.c_str(), 0755);
+  const int fd = open(cache_file.c_str(), O_RDONLY);
+  if(fd < 0) {
+    return;
+  }
+  struct stat info;
+  if(fstat(fd, &info) < 0 || info.st_size <= 0) {
+    close(fd);
+    return;
+  }
+  buffer_size = (size_t)info.st_size;
+  buffer = (char*)mmap(nullptr, buffer_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(buffer == MAP_FAILED) {
+    return;
+  }
+#endif
+
+  // validate: a file from another executable or VM build is ignored and replaced
+  size_t pos = 0;
+  char magic[4];
+  uint32_t format = 0;
+  uint64_t file_hash = 0;
+  uint64_t file_size = 0;
+  char stamp[JIT_CACHE_STAMP_SIZE];
+  uint32_t count = 0;
+  bool valid = CacheRead(buffer, buffer_size, pos, magic) && !memcmp(magic, JIT_CACHE_MAGIC, sizeof(magic)) &&
+    CacheRead(buffer, buffer_size, pos, format) && format == JIT_CACHE_FORMAT &&
+    CacheRead(buffer, buffer_size, pos, file_hash) && file_hash == image_hash &&
+    CacheRead(buffer, buffer_size, pos, file_size) && file_size == image_size &&
+    CacheRead(buffer, buffer_size, pos, stamp) && !strncmp(stamp, GetStamp(), sizeof(stamp)) &&
+    CacheRead(buffer, buffer_size, pos, count);
+
+  for(uint32_t i = 0; valid && i < count; ++i) {
+    const size_t start = pos;
+    JitCacheEntry entry;
+    valid = ParseRecord(buffer, buffer_size, pos, entry);
+    if(valid) {
+      StackClass* cls = program->GetClass(entry.cls_id);
+      if(cls && entry.mthd_id < cls->GetMethodCount()) {
+        const std::pair<long, long> key(entry.cls_id, entry.mthd_id);
+        records[key] = std::string(buffer + start, pos - start);
+        pending.push_back(key);
+        loaded_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+  if(!valid) {
+    records.clear();
+    pending.clear();
+    loaded_count.store(0, std::memory_order_relaxed);
+    dirty = true;
+  }
+
+#ifdef _WIN32
+  free(buffer);
+#else
+  munmap(buffer, buffer_size);
+#endif
+}
+
+bool JitCodeCache::ParseRecord(const char* buffer, size_t size, size_t &pos, JitCacheEntry &entry)
+{
+  int32_t cls_id, mthd_id, code_size, float_count, int_count, reloc_count, osr_count;
+  if(!CacheRead(buffer, size, pos, cls_id) || !CacheRead(buffer, size, pos, mthd_id) ||
+     !CacheRead(buffer, size, pos, code_size) || !CacheRead(buffer, size, pos, float_count) ||
+     !CacheRead(buffer, size, pos, int_count) || !CacheRead(buffer, size, pos, reloc_count) ||
+     !CacheRead(buffer, size, pos, osr_count)) {
+    return false;
+  }
+
+  if(cls_id < 0 || mthd_id < 0 || code_size <= 0 || float_count < 0 || int_count < 0 ||
+     reloc_count < 0 || osr_count < 0) {
+    return false;
+  }
+
+  const size_t needed = (size_t)code_size + (size_t)float_count * sizeof(FLOAT_VALUE) + (size_t)int_count * sizeof(int64_t) +
+    (size_t)reloc_count * sizeof(JitReloc) + (size_t)osr_count * sizeof(int64_t) * 2;
+  if(pos + needed > size) {
+    return false;
+  }
+
+  entry.cls_id = cls_id;
+  entry.mthd_id = mthd_id;
+
+  entry.code.assign(buffer + pos, buffer + pos + code_size);
+  pos += code_size;
+
+  entry.floats.resize(float_count);
+  for(int32_t i = 0; i < float_count; ++i) {
+    CacheRead(buffer, size, pos, entry.floats[i]);
+  }
+
+  entry.ints.resize(int_count);
+  for(int32_t i = 0; i < int_count; ++i) {
+    CacheRead(buffer, size, pos, entry.ints[i]);
+  }
+
+  entry.relocs.resize(reloc_count);
+  for(int32_t i = 0; i < reloc_count; ++i) {
+    CacheRead(buffer, size, pos, entry.relocs[i]);
+  }
+
+  entry.osr_entries.clear();
+  for(int32_t i = 0; i < osr_count; ++i) {
+    int64_t lbl_index, offset;
+    CacheRead(buffer, size, pos, lbl_index);
+    CacheRead(buffer, size, pos, offset);
+    if(offset < 0 || offset >= code_size) {
+      return false;
+    }
+    entry.osr_entries.push_back(std::pair<long, long>((long)lbl_index, (long)offset));
+  }
+
+  return true;
+}
+
+bool JitCodeCache::Next(JitCacheEntry &entry)
+{
+  if(!IsEnabled()) {
+    return false;
+  }
+
+  MUTEX_LOCK(&cache_lock);
+  while(!pending.empty()) {
+    const std::pair<long, long> key = pending.back();
+    pending.pop_back();
+
+    std::map<std::pair<long, long>, std::string>::iterator found = records.find(key);
+    if(found != records.end()) {
+      size_t pos = 0;
+      if(ParseRecord(found->second.c_str(), found->second.size(), pos, entry)) {
+        MUTEX_UNLOCK(&cache_lock);
+        return true;
+      }
+    }
+  }
+  MUTEX_UNLOCK(&cache_lock);
+
+  return false;
+}
+
+void JitCodeCache::Reject(const JitCacheEntry &entry)
+{
+  MUTEX_LOCK(&cache_lock);
+  records.erase(std::pair<long, long>(entry.cls_id, entry.mthd_id));
+  dirty = true;
+  MUTEX_UNLOCK(&cache_lock);
+  rejected_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JitCodeCache::Store(const JitCacheEntry &entry)
+{
+  if(!IsEnabled()) {
+    return;
+  }
+
+  std::string record;
+  CacheWrite(record, (int32_t)entry.cls_id);
+  CacheWrite(record, (int32_t)entry.mthd_id);
+  CacheWrite(record, (int32_t)entry.code.size());
+  CacheWrite(record, (int32_t)entry.floats.size());
+  CacheWrite(record, (int32_t)entry.ints.size());
+  CacheWrite(record, (int32_t)entry.relocs.size());
+  CacheWrite(record, (int32_t)entry.osr_entries.size());
+  record.append((const char*)entry.code.data(), entry.code.size());
+  for(size_t i = 0; i < entry.floats.size(); ++i) {
+    CacheWrite(record, entry.floats[i]);
+  }
+  for(size_t i = 0; i < entry.ints.size(); ++i) {
+    CacheWrite(record, entry.ints[i]);
+  }
+  for(size_t i = 0; i < entry.relocs.size(); ++i) {
+    CacheWrite(record, entry.relocs[i]);
+  }
+  for(size_t i = 0; i < entry.osr_entries.size(); ++i) {
+    CacheWrite(record, (int64_t)entry.osr_entries[i].first);
+    CacheWrite(record, (int64_t)entry.osr_entries[i].second);
+  }
+
+  MUTEX_LOCK(&cache_lock);
+  records[std::pair<long, long>(entry.cls_id, entry.mthd_id)] = record;
+  dirty = true;
+  MUTEX_UNLOCK(&cache_lock);
+  stored_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JitCodeCache::Save()
+{
+  if(!IsEnabled()) {
+    return;
+  }
+
+  MUTEX_LOCK(&cache_lock);
+  if(!dirty) {
+    MUTEX_UNLOCK(&cache_lock);
+    return;
+  }
+
+  std::string out;
+  out.append(JIT_CACHE_MAGIC, 4);
+  CacheWrite(out, (uint32_t)JIT_CACHE_FORMAT);
+  CacheWrite(out, image_hash);
+  CacheWrite(out, image_size);
+  char stamp[JIT_CACHE_STAMP_SIZE] = { 0 };
+  strncpy(stamp, GetStamp(), sizeof(stamp) - 1);
+  out.append(stamp, sizeof(stamp));
+  CacheWrite(out, (uint32_t)records.size());
+  for(std::map<std::pair<long, long>, std::string>::iterator iter = records.begin(); iter != records.end(); ++iter) {
+    out.append(iter->second);
+  }
+  dirty = false;
+  MUTEX_UNLOCK(&cache_lock);
+
+  // write then rename, so a concurrent run never maps a partial file
+  std::stringstream tmp_name;
+#ifdef _WIN32
+  tmp_name << cache_file << '.' << GetCurrentProcessId();
+#else
+  tmp_name << cache_file << '.' << getpid();
+#endif
+  const std::string tmp_file = tmp_name.str();
+  std::ofstream file_out(tmp_file.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if(!file_out.good()) {
+    return;
+  }
+  file_out.write(out.c_str(), out.size());
+  file_out.close();
+  if(!file_out.good()) {
+    remove(tmp_file.c_str());
+    return;
+  }
+#ifdef _WIN32
+  remove(cache_file.c_str());
+#endif
+  if(rename(tmp_file.c_str(), cache_file.c_str())) {
+    remove(tmp_file.c_str());
+  }
+}
+
+size_t JitCodeCache::Resolve(StackProgram* program, const JitReloc &reloc, const FLOAT_VALUE* floats, long float_count)
+{
+  switch(reloc.type) {
+  case JIT_RELOC_RUNTIME:
+    if(reloc.value >= 0 && reloc.value < symbol_count) {
+      return symbols[reloc.value];
+    }
+    break;
+
+  case JIT_RELOC_FLOAT:
+    if(reloc.value >= 0 && reloc.value % sizeof(FLOAT_VALUE) == 0 &&
+       (size_t)reloc.value < (size_t)float_count * sizeof(FLOAT_VALUE)) {
+      return (size_t)floats + reloc.value;
+    }
+    break;
+
+  case JIT_RELOC_CLASS:
+    if(reloc.value >= 0 && reloc.value < program->GetClassNumber()) {
+      return (size_t)program->GetClass(reloc.value);
+    }
+    break;
+
+  case JIT_RELOC_INSTR:
+    if(reloc.cls_id >= 0 && reloc.cls_id < program->GetClassNumber()) {
+      StackClass* cls = program->GetClass(reloc.cls_id);
+      if(cls && reloc.mthd_id >= 0 && reloc.mthd_id < cls->GetMethodCount()) {
+        StackMethod* mthd = cls->GetMethod(reloc.mthd_id);
+        if(mthd && reloc.value >= 0 && reloc.value < mthd->GetInstructionCount()) {
+          return (size_t)mthd->GetInstruction(reloc.value);
+        }
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  return 0;
+}
 #endif
 
 /**
@@ -174,6 +736,20 @@ void JitCompiler::JitStackCallback(const long instr_id, StackInstr* instr, const
     }
     else {
       callee = program->GetClass(instr->GetOperand())->GetMethod(instr->GetOperand2());
+      // virtual call: the receiver's target from the call site's inline cache
+      // (shared with the interpreter), or the class's resolved methods once the
+      // site is megamorphic, so a warm site calls its native code directly
+      // instead of re-dispatching through the interpreter
+      if(callee->IsVirtual()) {
+        StackClass* receiver_class = MemoryManager::GetClass((size_t*)op_stack[(*stack_pos) - 1]);
+        StackMethod* cached_callee = instr->LookupCall(receiver_class);
+        if(!cached_callee && receiver_class) {
+          cached_callee = receiver_class->GetVirtualMethod(instr->GetOperand(), instr->GetOperand2());
+        }
+        if(cached_callee) {
+          callee = cached_callee;
+        }
+      }
     }
 
 #ifndef _NO_JIT
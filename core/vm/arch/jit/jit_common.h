@@ -41,6 +41,8 @@
 #include "../../common.h"
 #include "../../interpreter.h"
 #include <climits>
+#include <queue>
+#include <map>
 
 // Auto-JIT: methods called more than threshold times are JIT compiled.
 // Pre-scan validation (CanJitInstruction) runs before resource allocation,
@@ -53,6 +55,8 @@
 // several latent JIT miscompiles (chained transcendental float calls produce
 // NaN, string-interpolation paths, etc.). Those must be fixed first. See the
 // DYN_MTHD_CALL fixes in this change set for two such bugs already addressed.
+// On-stack replacement (below) now compiles such a method from its hot loop
+// without lowering the call threshold.
 // Tunables:
 //   OBJECK_JIT_DISABLE=1   — turn auto-JIT off entirely
 //   OBJECK_JIT_THRESHOLD=N — call-count threshold (must be positive)
@@ -106,7 +110,259 @@ inline long GetJitAutoThreshold() {
 
 #define JIT_AUTO_THRESHOLD GetJitAutoThreshold()
 
+// On-stack replacement: once an interpreted method's loops have taken this many
+// back-edges it is compiled, and the running call resumes in native code at the
+// loop header (StackInterpreter::ProcessOsrEntry). This covers a method that is
+// entered once but spends its time in a loop, e.g. Main. Off when auto-JIT is.
+// Tunables:
+//   OBJECK_JIT_OSR_THRESHOLD=N — back-edge threshold (must be positive)
+#define JIT_OSR_THRESHOLD_DEFAULT 1000
+
+inline long GetJitOsrThreshold() {
+  static long threshold = -1;
+  if(threshold < 0) {
+    if(GetJitAutoThreshold() == JIT_AUTO_THRESHOLD_DISABLED) {
+      threshold = JIT_AUTO_THRESHOLD_DISABLED;
+      return threshold;
+    }
+    threshold = JIT_OSR_THRESHOLD_DEFAULT;
+
+#ifdef _WIN32
+    char* env_val = nullptr;
+    size_t len = 0;
+    if(_dupenv_s(&env_val, &len, "OBJECK_JIT_OSR_THRESHOLD") == 0 && env_val) {
+      const long parsed = std::atol(env_val);
+      if(parsed > 0) {
+        threshold = parsed;
+      }
+      free(env_val);
+    }
+#else
+    const char* env_val = std::getenv("OBJECK_JIT_OSR_THRESHOLD");
+    if(env_val) {
+      const long parsed = std::atol(env_val);
+      if(parsed > 0) {
+        threshold = parsed;
+      }
+    }
+#endif
+  }
+  return threshold;
+}
+
+#define JIT_OSR_THRESHOLD GetJitOsrThreshold()
+
+// Background compilation: a method that crosses a threshold is queued for a
+// dedicated compiler thread instead of being compiled by the mutator that
+// tripped it; callers keep interpreting until the compile is published.
+// Tunables:
+//   OBJECK_JIT_BACKGROUND=0 — compile synchronously on the calling thread
+inline bool GetJitBackground() {
+  static int background = -1;
+  if(background < 0) {
+    background = 1;
+#ifdef _WIN32
+    char* env_val = nullptr;
+    size_t len = 0;
+    if(_dupenv_s(&env_val, &len, "OBJECK_JIT_BACKGROUND") == 0 && env_val) {
+      background = (env_val[0] == '0' && env_val[1] == '\0') ? 0 : 1;
+      free(env_val);
+    }
+#else
+    const char* env_val = std::getenv("OBJECK_JIT_BACKGROUND");
+    if(env_val && env_val[0] == '0' && env_val[1] == '\0') {
+      background = 0;
+    }
+#endif
+  }
+  return background == 1;
+}
+
+// A claimed method waiting for the compiler thread. Hotter methods (call plus
+// back-edge counts when queued) compile first; ties go in arrival order.
+struct JitCompileTask {
+  StackMethod* method;
+  long heat;
+  long seq;
+
+  bool operator<(const JitCompileTask& rhs) const {
+    if(heat != rhs.heat) {
+      return heat < rhs.heat;
+    }
+    return seq > rhs.seq;
+  }
+};
+
+// Persistent code cache: native code compiled during one run is written to disk
+// at exit and installed when the same executable starts again, so its hot
+// methods run native from their first call instead of re-warming. Off unless a
+// directory is given.
+// Tunables:
+//   OBJECK_JIT_CACHE=dir — read and write cached code under 'dir'
+inline const std::string& GetJitCacheDir() {
+  static bool checked = false;
+  static std::string cache_dir;
+  if(!checked) {
+    checked = true;
+#ifdef _WIN32
+    char* env_val = nullptr;
+    size_t len = 0;
+    if(_dupenv_s(&env_val, &len, "OBJECK_JIT_CACHE") == 0 && env_val) {
+      cache_dir = env_val;
+      free(env_val);
+    }
+#else
+    const char* env_val = std::getenv("OBJECK_JIT_CACHE");
+    if(env_val) {
+      cache_dir = env_val;
+    }
+#endif
+    // an explicitly disabled JIT has nothing to cache
+    if(GetJitAutoThreshold() == JIT_AUTO_THRESHOLD_DISABLED) {
+      cache_dir.clear();
+    }
+  }
+  return cache_dir;
+}
+
+// Absolute addresses embedded in native code. The compilers emit them at fixed
+// width and record where, so cached code can be re-pointed at this process.
+enum JitRelocType {
+  JIT_RELOC_RUNTIME = 0, // VM/libm entry point or variable (JitCodeCache symbol id)
+  JIT_RELOC_FLOAT,       // method float pool (byte offset)
+  JIT_RELOC_CLASS,       // StackClass (class id)
+  JIT_RELOC_INSTR        // StackInstr (owning class/method id, instruction index)
+};
+
+// On disk as is. 'site' is the code offset of the 64-bit immediate (amd64) or the
+// integer pool index holding the address (arm64).
+struct JitReloc {
+  int64_t site;
+  int32_t type;
+  int32_t value;
+  int32_t cls_id;
+  int32_t mthd_id;
+};
+
+// A compiled method in cache file form
+struct JitCacheEntry {
+  long cls_id;
+  long mthd_id;
+  std::vector<unsigned char> code;
+  std::vector<FLOAT_VALUE> floats;
+  std::vector<int64_t> ints;
+  std::vector<JitReloc> relocs;
+  std::vector<std::pair<long, long>> osr_entries;
+};
+
+#define JIT_CACHE_MAX_SYMBOLS 64
+
+class JitCodeCache {
+  static std::string cache_file;
+  static uint64_t image_hash;
+  static uint64_t image_size;
+  // serialized method records, keyed by class and method id
+  static std::map<std::pair<long, long>, std::string> records;
+  static std::vector<std::pair<long, long>> pending;
+  static bool dirty;
+#ifdef _WIN32
+  static CRITICAL_SECTION cache_lock;
+#else
+  static pthread_mutex_t cache_lock;
+#endif
+  // plain array: compiles still running when exit() tears down statics read it
+  static size_t symbols[JIT_CACHE_MAX_SYMBOLS];
+  static long symbol_count;
+
+  static std::atomic<long> loaded_count;
+  static std::atomic<long> installed_count;
+  static std::atomic<long> stored_count;
+  static std::atomic<long> rejected_count;
+
+  static const char* GetStamp();
+  static void InitSymbols();
+  static bool ParseRecord(const char* buffer, size_t size, size_t &pos, JitCacheEntry &entry);
+
+public:
+  // maps and validates the cache file for a loaded executable image
+  static void Open(StackProgram* program, const char* image, size_t size);
+
+  // writes cached and newly compiled methods back, if anything changed
+  static void Save();
+
+  static bool IsEnabled() {
+    return !cache_file.empty();
+  }
+
+  // next cached method to install; false once all have been handed out
+  static bool Next(JitCacheEntry &entry);
+
+  // an entry that did not resolve, dropped from the file
+  static void Reject(const JitCacheEntry &entry);
+
+  static void Installed() {
+    installed_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // records a compiled method for the next run
+  static void Store(const JitCacheEntry &entry);
+
+  // resolves a relocation against this process; 0 if it does not resolve
+  static size_t Resolve(StackProgram* program, const JitReloc &reloc, const FLOAT_VALUE* floats, long float_count);
+
+  // symbol id for a VM/libm address, or -1 (the method is then not cached)
+  static long GetSymbol(size_t addr);
+
+  static long GetLoadedCount() {
+    return loaded_count.load(std::memory_order_relaxed);
+  }
+
+  static long GetInstalledCount() {
+    return installed_count.load(std::memory_order_relaxed);
+  }
+
+  static long GetStoredCount() {
+    return stored_count.load(std::memory_order_relaxed);
+  }
+
+  static long GetRejectedCount() {
+    return rejected_count.load(std::memory_order_relaxed);
+  }
+};
+
 class JitCompiler {
+  // background compiler thread, started on the first queued method
+  static std::priority_queue<JitCompileTask> compile_queue;
+  static long compile_seq;
+  static bool compile_thread_started;
+  static bool compile_thread_stop;
+#ifdef _WIN32
+  static CRITICAL_SECTION compile_lock;
+  static CONDITION_VARIABLE compile_cv;
+  static HANDLE compile_thread;
+#else
+  static pthread_mutex_t compile_lock;
+  static pthread_cond_t compile_cv;
+  static pthread_t compile_thread;
+#endif
+
+  // runtime.jit.* statistics
+  static std::atomic<long> compiled_count;
+  static std::atomic<long> failed_count;
+  static std::atomic<long> queue_depth;
+  static std::atomic<long> queue_max;
+  static std::atomic<long> compile_last_us;
+  static std::atomic<long> compile_max_us;
+  static std::atomic<long> compile_total_us;
+
+  static bool CompileClaimed(StackMethod* callee);
+  static void QueueCompile(StackMethod* callee);
+#ifdef _WIN32
+  static unsigned int WINAPI CompileThreadMain(LPVOID arg);
+#else
+  static void* CompileThreadMain(void* arg);
+#endif
+
 protected:
   static StackProgram* program;
 
@@ -124,6 +380,38 @@ public:
   static bool TryAutoJitCompile(StackMethod* callee);
   static void PatchCallSites(StackMethod* callee, long patch_value);
 
+  // stops the compiler thread once the compile in flight finishes; queued
+  // methods are dropped so nothing touches the program after VM teardown
+  static void StopCompileThread();
+
+  static long GetCompiledCount() {
+    return compiled_count.load(std::memory_order_relaxed);
+  }
+
+  static long GetFailedCount() {
+    return failed_count.load(std::memory_order_relaxed);
+  }
+
+  static long GetQueueDepth() {
+    return queue_depth.load(std::memory_order_relaxed);
+  }
+
+  static long GetQueueMax() {
+    return queue_max.load(std::memory_order_relaxed);
+  }
+
+  static long GetCompileLastUs() {
+    return compile_last_us.load(std::memory_order_relaxed);
+  }
+
+  static long GetCompileMaxUs() {
+    return compile_max_us.load(std::memory_order_relaxed);
+  }
+
+  static long GetCompileTotalUs() {
+    return compile_total_us.load(std::memory_order_relaxed);
+  }
+
   // True if the method contains a trap that reads or writes interpreter
   // locals via frame->mem (SERL_* writers, SYS_TIME/GMT_TIME, FILE_*_TIME,
   // LOAD_CLS_BY_INST). JIT-compiled methods keep locals in native stack
@@ -39,9 +39,46 @@ std::unordered_set<StackFrame**> MemoryManager::pda_frames;
 std::unordered_set<StackFrameMonitor*> MemoryManager::pda_monitors;
 std::unordered_set<size_t**> MemoryManager::pending_thread_roots;
 std::vector<StackFrame*> MemoryManager::jit_frames;
-
-size_t* MemoryManager::free_buckets[MemoryManager::FREE_POOL_COUNT];
-std::atomic<size_t> MemoryManager::free_memory_cache_size;
+std::vector<StackFrame*> MemoryManager::gc_pda_frames;
+std::vector<std::pair<size_t*, size_t> > MemoryManager::gc_op_stacks;
+
+// Parallel mark workers
+GcWorker* MemoryManager::gc_workers;
+long MemoryManager::gc_worker_count;
+thread_local GcWorker* MemoryManager::gc_worker;
+std::atomic<long> MemoryManager::gc_active_workers;
+std::vector<GcRootTask> MemoryManager::gc_root_tasks;
+std::atomic<size_t> MemoryManager::gc_root_next;
+CollectionInfo* MemoryManager::gc_info;
+bool MemoryManager::gc_workers_started;
+bool MemoryManager::gc_workers_stop;
+long MemoryManager::gc_mark_epoch;
+long MemoryManager::gc_workers_done;
+#ifdef _WIN32
+CRITICAL_SECTION MemoryManager::gc_pool_lock;
+CONDITION_VARIABLE MemoryManager::gc_start_cv;
+CONDITION_VARIABLE MemoryManager::gc_done_cv;
+std::vector<HANDLE> MemoryManager::gc_threads;
+#else
+pthread_mutex_t MemoryManager::gc_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t MemoryManager::gc_start_cv = PTHREAD_COND_INITIALIZER;
+pthread_cond_t MemoryManager::gc_done_cv = PTHREAD_COND_INITIALIZER;
+std::vector<pthread_t> MemoryManager::gc_threads;
+#endif
+
+bool MemoryManager::gc_concurrent;
+std::atomic<bool> MemoryManager::concurrent_cycle(false);
+std::atomic<bool> MemoryManager::concurrent_mark(false);
+std::atomic<bool> MemoryManager::concurrent_abort(false);
+std::atomic<bool> MemoryManager::concurrent_done(false);
+bool MemoryManager::concurrent_thread_live;
+size_t MemoryManager::concurrent_start_size;
+bool MemoryManager::concurrent_remark;
+#ifdef _WIN32
+HANDLE MemoryManager::concurrent_thread;
+#else
+pthread_t MemoryManager::concurrent_thread;
+#endif
 
 bool MemoryManager::initialized;
 std::atomic<size_t> MemoryManager::allocation_size;
@@ -57,6 +94,13 @@ std::atomic<size_t> MemoryManager::gc_promoted_last(0);
 std::atomic<size_t> MemoryManager::gc_promoted_total(0);
 std::atomic<size_t> MemoryManager::gc_alloc_at_last(0);
 std::atomic<long> MemoryManager::gc_contention(0);
+std::atomic<long> MemoryManager::gc_concurrent_cycles(0);
+std::atomic<long> MemoryManager::gc_concurrent_incomplete(0);
+std::atomic<long> MemoryManager::gc_concurrent_mark_last_us(0);
+std::atomic<long> MemoryManager::gc_initial_mark_last_us(0);
+std::atomic<long> MemoryManager::gc_initial_mark_max_us(0);
+std::atomic<long> MemoryManager::gc_remark_last_us(0);
+std::atomic<long> MemoryManager::gc_remark_max_us(0);
 // Process start, for runtime.uptime_ms and the alloc-rate derivation.
 static std::chrono::steady_clock::time_point g_mm_start_time = std::chrono::steady_clock::now();
 
@@ -70,13 +114,50 @@ uint8_t* MemoryManager::young_region;
 size_t MemoryManager::young_region_size;
 std::atomic<size_t> MemoryManager::young_offset;
 
+// Thread-local allocation buffers
+#ifdef _TLAB_JIT_INLINE
+thread_local ThreadAllocBuffer MemoryManager::tlab __attribute__((tls_model("initial-exec")));
+#else
+thread_local ThreadAllocBuffer MemoryManager::tlab;
+#endif
+std::unordered_set<ThreadAllocBuffer*> MemoryManager::tlab_buffers;
+
+// Registers a thread's allocation buffer on its first refill and retires it when
+// the thread exits, so an exited thread's unused chunk is left as a parsable gap
+// rather than a hole in the nursery walk.
+struct AllocBufferRegistration {
+  bool registered = false;
+
+  ~AllocBufferRegistration() {
+    if(!registered || !MemoryManager::initialized) {
+      return;
+    }
+    MUTEX_LOCK(&MemoryManager::tlab_lock);
+    MemoryManager::RetireAllocBuffer(&MemoryManager::tlab);
+    MemoryManager::tlab_buffers.erase(&MemoryManager::tlab);
+    MUTEX_UNLOCK(&MemoryManager::tlab_lock);
+  }
+};
+static thread_local AllocBufferRegistration tlab_registration;
+
 // Old generation
-std::unordered_set<size_t*> MemoryManager::old_generation;
+OldPage** MemoryManager::old_page_map[(size_t)1 << OLD_MAP_ROOT_BITS];
+std::vector<OldPage*> MemoryManager::old_pages;
+std::vector<OldPage*> MemoryManager::old_empty;
+OldPage* MemoryManager::old_partial[OLD_CLASS_MAX];
+size_t MemoryManager::old_class_size[OLD_CLASS_MAX];
+size_t MemoryManager::old_class_count;
+uint8_t MemoryManager::old_class_index[OLD_SMALL_MAX / OLD_GRANULE + 1];
+size_t MemoryManager::old_object_count;
 size_t MemoryManager::old_allocation_size;
 
-// Lock-free dirty list
-size_t* MemoryManager::dirty_list[DIRTY_LIST_MAX];
-std::atomic<size_t> MemoryManager::dirty_count;
+// Cells start after the page header, on a granule boundary
+static const size_t OLD_PAGE_HEADER = (sizeof(OldPage) + OLD_GRANULE - 1) & ~(OLD_GRANULE - 1);
+static_assert(OLD_PAGE_HEADER + OLD_SMALL_MAX <= OLD_PAGE_SIZE, "largest size class must fit a page");
+static_assert(OLD_CARD_GRANULES < 64 && 64 % OLD_CARD_GRANULES == 0, "a card's alloc bits must sit in one bitmap word");
+
+std::atomic<size_t> MemoryManager::remembered_count;
+bool MemoryManager::gc_verify;
 
 std::atomic<bool> MemoryManager::minor_gc_mode;
 std::atomic<long> MemoryManager::mutator_count(1);   // main thread is mutator #1
@@ -103,7 +184,7 @@ CRITICAL_SECTION MemoryManager::pda_monitor_lock;
 CRITICAL_SECTION MemoryManager::pending_thread_root_lock;
 CRITICAL_SECTION MemoryManager::allocated_lock;
 CRITICAL_SECTION MemoryManager::marked_sweep_lock;
-CRITICAL_SECTION MemoryManager::free_memory_cache_lock;
+CRITICAL_SECTION MemoryManager::tlab_lock;
 #else
 pthread_mutex_t MemoryManager::pda_monitor_lock = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t MemoryManager::pda_frame_lock = PTHREAD_MUTEX_INITIALIZER;
@@ -111,7 +192,7 @@ pthread_mutex_t MemoryManager::jit_frame_lock = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t MemoryManager::pending_thread_root_lock = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t MemoryManager::allocated_lock = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t MemoryManager::marked_sweep_lock = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t MemoryManager::free_memory_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t MemoryManager::tlab_lock = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 void MemoryManager::Initialize(StackProgram* p, size_t m)
@@ -125,11 +206,15 @@ void MemoryManager::Initialize(StackProgram* p, size_t m)
   }
   allocation_size = 0;
   uncollected_count = 0;
-  free_memory_cache_size.store(0, std::memory_order_relaxed);
-  memset(free_buckets, 0, sizeof(free_buckets));
+
+  // GC verification and stress modes (see gc_verify)
+  const std::wstring gc_stress_prop = StackProgram::GetProperty(L"gc-stress");
+  const std::wstring gc_verify_prop = StackProgram::GetProperty(L"gc-verify");
+  const bool gc_stress = gc_stress_prop == L"true" || gc_stress_prop == L"1";
+  gc_verify = gc_stress || gc_verify_prop == L"true" || gc_verify_prop == L"1";
 
   // Young generation bump allocator
-  young_region_size = YOUNG_REGION_SIZE;
+  young_region_size = gc_stress ? YOUNG_STRESS_SIZE : YOUNG_REGION_SIZE;
 #ifdef _WIN32
   young_region = (uint8_t*)VirtualAlloc(nullptr, young_region_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
 #else
@@ -144,17 +229,86 @@ void MemoryManager::Initialize(StackProgram* p, size_t m)
   }
   young_offset.store(0, std::memory_order_relaxed);
 
-  // Old generation — reserve larger initial capacity to reduce rehashing
-  // for workloads that allocate many objects (e.g. binarytrees creates millions)
+  // Old generation size classes: 16-byte steps up to 256 bytes, then four steps
+  // per doubling up to OLD_SMALL_MAX (at most 25% internal fragmentation)
+  old_class_count = 0;
+  for(size_t size = OLD_GRANULE; size <= OLD_SMALL_MAX; ) {
+    old_class_size[old_class_count++] = size;
+    size_t step = OLD_GRANULE;
+    if(size >= 256) {
+      size_t base = 256;
+      while(base * 2 <= size) {
+        base *= 2;
+      }
+      step = base / 4;
+    }
+    size += step;
+  }
+  for(size_t i = 0, c = 0; i <= OLD_SMALL_MAX / OLD_GRANULE; ++i) {
+    while(old_class_size[c] < i * OLD_GRANULE) {
+      ++c;
+    }
+    old_class_index[i] = (uint8_t)c;
+  }
+  memset(old_partial, 0, sizeof(old_partial));
+  old_object_count = 0;
   old_allocation_size = 0;
-  old_generation.reserve(65536);
 
-  // Dirty list
-  memset(dirty_list, 0, sizeof(dirty_list));
-  dirty_count.store(0, std::memory_order_relaxed);
+  remembered_count.store(0, std::memory_order_relaxed);
 
   minor_gc_mode.store(false, std::memory_order_relaxed);
 
+  // Mark workers: 'gc-threads' in config.prop, else one per core (capped)
+  gc_worker_count = 1;
+#ifndef _GC_SERIAL
+  gc_worker_count = (long)std::thread::hardware_concurrency();
+  if(gc_worker_count > GC_THREADS_DEFAULT) {
+    gc_worker_count = GC_THREADS_DEFAULT;
+  }
+  const std::wstring gc_threads_prop = StackProgram::GetProperty(L"gc-threads");
+  if(!gc_threads_prop.empty()) {
+    gc_worker_count = std::wcstol(gc_threads_prop.c_str(), nullptr, 10);
+  }
+  if(gc_worker_count < 1) {
+    gc_worker_count = 1;
+  }
+  else if(gc_worker_count > GC_THREADS_MAX) {
+    gc_worker_count = GC_THREADS_MAX;
+  }
+#endif
+  gc_workers = new GcWorker[gc_worker_count];
+  for(long i = 0; i < gc_worker_count; ++i) {
+    gc_workers[i].shared_size.store(0, std::memory_order_relaxed);
+#ifdef _WIN32
+    InitializeCriticalSection(&gc_workers[i].shared_lock);
+#else
+    pthread_mutex_init(&gc_workers[i].shared_lock, nullptr);
+#endif
+  }
+  gc_active_workers.store(0, std::memory_order_relaxed);
+  gc_workers_started = gc_workers_stop = false;
+  gc_mark_epoch = gc_workers_done = 0;
+
+  // Concurrent marking: 'gc-concurrent' in config.prop, overridden by the
+  // OBJECK_GC_CONCURRENT environment variable
+  std::wstring gc_concurrent_prop = StackProgram::GetProperty(L"gc-concurrent");
+#ifdef _WIN32
+  size_t gc_concurrent_env_len;
+  char gc_concurrent_env[SMALL_BUFFER_MAX];
+  if(!getenv_s(&gc_concurrent_env_len, gc_concurrent_env, SMALL_BUFFER_MAX, "OBJECK_GC_CONCURRENT") && strlen(gc_concurrent_env) > 0) {
+    gc_concurrent_prop = BytesToUnicode(gc_concurrent_env);
+  }
+#else
+  const char* gc_concurrent_env = getenv("OBJECK_GC_CONCURRENT");
+  if(gc_concurrent_env && strlen(gc_concurrent_env) > 0) {
+    gc_concurrent_prop = BytesToUnicode(gc_concurrent_env);
+  }
+#endif
+  gc_concurrent = gc_concurrent_prop == L"true" || gc_concurrent_prop == L"1";
+  concurrent_cycle.store(false, std::memory_order_relaxed);
+  concurrent_mark.store(false, std::memory_order_relaxed);
+  concurrent_thread_live = concurrent_remark = false;
+
 #ifdef _MEM_LOGGING
   mem_logger.open("mem_log.csv");
   mem_logger << L"cycle,oper,type,addr,size" << std::endl;
@@ -167,9 +321,12 @@ void MemoryManager::Initialize(StackProgram* p, size_t m)
   InitializeCriticalSection(&pending_thread_root_lock);
   InitializeCriticalSection(&allocated_lock);
   InitializeCriticalSection(&marked_sweep_lock);
-  InitializeCriticalSection(&free_memory_cache_lock);
+  InitializeCriticalSection(&tlab_lock);
   InitializeCriticalSection(&stw_lock);
   InitializeConditionVariable(&stw_cv);
+  InitializeCriticalSection(&gc_pool_lock);
+  InitializeConditionVariable(&gc_start_cv);
+  InitializeConditionVariable(&gc_done_cv);
 #endif
 
   mutator_count.store(1, std::memory_order_relaxed);   // main thread
@@ -251,10 +408,17 @@ FLOAT_VALUE MemoryManager::GetRandomValue() {
 }
 
 // if return true, trace memory otherwise do not
-// Generational: mark bit is bit 0 of MARKED_FLAG, preserving gen/age/rset bits
+// Generational: a young object's mark bit is bit 0 of MARKED_FLAG, preserving
+// gen/age/rset bits; an old object is marked in its page's side bitmap. The
+// generation is decided by address, not by GC_OLD_BIT: a concurrent tracer can
+// reach an old cell whose header the allocating thread has not written yet.
 inline bool MemoryManager::MarkMemory(size_t* mem)
 {
   if(mem) {
+    if(!IsYoung(mem)) {
+      return MarkOldMemory(mem);
+    }
+
     // check if memory has been marked (bit 0)
     if(mem[MARKED_FLAG] & GC_MARK_BIT) {
       return false;
@@ -282,6 +446,37 @@ inline bool MemoryManager::MarkMemory(size_t* mem)
   return false;
 }
 
+// Old-gen objects live in the first page of their run, so the header is found by
+// masking. Mark threads race on bitmap words shared by neighbouring cells, so the
+// bit is set with an atomic OR.
+inline bool MemoryManager::MarkOldMemory(size_t* mem)
+{
+  const uintptr_t raw = (uintptr_t)(mem - EXTRA_BUF_SIZE - 1);
+  OldPage* page = (OldPage*)(raw & ~(OLD_PAGE_SIZE - 1));
+  const size_t bit = (raw & (OLD_PAGE_SIZE - 1)) >> OLD_GRANULE_SHIFT;
+  size_t* word = &page->mark_bits[bit >> 6];
+  const size_t mask = (size_t)1 << (bit & 63);
+  if(*word & mask) {
+    return false;
+  }
+
+#ifndef _GC_SERIAL
+#ifdef _WIN32
+  const size_t prev = (size_t)_InterlockedOr64((volatile LONG64*)word, (LONG64)mask);
+#else
+  const size_t prev = __atomic_fetch_or(word, mask, __ATOMIC_RELAXED);
+#endif
+  if(prev & mask) {
+    return false;
+  }
+#else
+  *word |= mask;
+#endif
+  page->has_marks.store(true, std::memory_order_relaxed);
+
+  return true;
+}
+
 void MemoryManager::AddPdaMethodRoot(StackFrame** frame)
 {
   if(!initialized) {
@@ -459,84 +654,70 @@ size_t* MemoryManager::AllocateObject(const long obj_id, size_t* op_stack, size_
     // Align to sizeof(size_t) boundary for bump allocator
     const size_t aligned_total = (total_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
 
-    // Try young generation bump allocation first. Advance young_offset with a CAS
-    // that commits ONLY when the block fits: a plain fetch_add over-advances under
-    // concurrency (many threads add past the end without rolling back), leaving
-    // young_offset > young_region_size. The collector then uses young_offset as the
-    // length of its young walk + reset memset, running off the end of the mapping —
-    // promoting garbage as objects (corruption) and overrunning memset (crash).
+    // Try the young generation first: bump-allocate from this thread's TLAB
+    // (see AllocateYoung). When the nursery is exhausted, collect to promote
+    // survivors and reset it, then retry once.
     if(young_region) {
-      size_t offset = young_offset.load(std::memory_order_relaxed);
-      while(offset + aligned_total <= young_region_size) {
-        if(young_offset.compare_exchange_weak(offset, offset + aligned_total,
-                                              std::memory_order_relaxed)) {
-          // Bump allocation succeeded
-          size_t* raw_mem = (size_t*)(young_region + offset);
-          raw_mem[0] = alloc_size;  // store size for promotion
-          mem = raw_mem + 1;
-          mem[EXTRA_BUF_SIZE + TYPE] = NIL_TYPE;
-          mem[EXTRA_BUF_SIZE + SIZE_OR_CLS] = (size_t)cls;
-          mem += EXTRA_BUF_SIZE;
-          // Young object: no GC_OLD_BIT, no hash set insert, no mutex.
-          // Explicitly clear the GC flag word.
-          mem[MARKED_FLAG] = 0;
-          // Zero the object's field words here (zero-on-alloc) instead of relying on a
-          // post-collection memset of the whole nursery. The old design zeroed the
-          // entire used nursery inside the stop-the-world pause (up to nursery-size of
-          // memset on every GC -> a big latency spike for allocation-heavy code). The
-          // total zeroing work is the same, but moving it to the allocator takes it out
-          // of the pause and gives better cache locality (we are about to write the
-          // object anyway). Field bytes = alloc_size - the EXTRA_BUF header words.
-          memset(mem, 0, (size_t)alloc_size - sizeof(size_t) * EXTRA_BUF_SIZE);
-          // release fence: header stores must be visible before this object can be
-          // observed as young (pairs with the acquire load of young_offset in IsYoung).
-          std::atomic_thread_fence(std::memory_order_release);
-          allocation_size.fetch_add(size, std::memory_order_relaxed);
-          return mem;
-        }
-        // CAS failed: offset was reloaded with the current value — re-test and retry
-      }
-      // Young gen full — collect to promote survivors and reset the nursery.
-      if(collect) {
+      uint8_t* young_mem = AllocateYoung(aligned_total);
+      if(!young_mem && collect) {
         // Minor GC (scan the remembered set + roots, promote reachable young
         // objects, recycle the nursery without sweeping old gen) is the common,
         // cheap case. Fall back to a full major GC once the old generation has
         // grown past the heap threshold, since only a major GC reclaims dead
         // old-gen objects. Requires the JIT/interpreter write barriers (H1) so the
-        // remembered set captures every old->young store.
-        if(old_allocation_size > mem_max_size) {
+        // remembered set captures every old->young store. With 'gc-concurrent' the
+        // minor GC starts a concurrent cycle instead, or finishes the running one.
+        if(!gc_concurrent && old_allocation_size > mem_max_size) {
           CollectMajor(op_stack, stack_pos);
         }
         else {
           CollectMinor(op_stack, stack_pos);
         }
-        // Retry bump allocation after GC (young_offset reset to 0)
-        size_t retry_offset = young_offset.load(std::memory_order_relaxed);
-        while(retry_offset + aligned_total <= young_region_size) {
-          if(young_offset.compare_exchange_weak(retry_offset, retry_offset + aligned_total,
-                                                std::memory_order_relaxed)) {
-            size_t* raw_mem = (size_t*)(young_region + retry_offset);
-            raw_mem[0] = alloc_size;
-            mem = raw_mem + 1;
-            mem[EXTRA_BUF_SIZE + TYPE] = NIL_TYPE;
-            mem[EXTRA_BUF_SIZE + SIZE_OR_CLS] = (size_t)cls;
-            mem += EXTRA_BUF_SIZE;
-            mem[MARKED_FLAG] = 0;
-            // Zero-on-alloc (see the initial bump path above for the rationale).
-            memset(mem, 0, (size_t)alloc_size - sizeof(size_t) * EXTRA_BUF_SIZE);
-            std::atomic_thread_fence(std::memory_order_release);
-            allocation_size.fetch_add(size, std::memory_order_relaxed);
-            return mem;
-          }
-        }
+        young_mem = AllocateYoung(aligned_total);
+      }
+
+      if(young_mem) {
+        size_t* raw_mem = (size_t*)young_mem;
+        raw_mem[0] = alloc_size;  // store size for promotion
+        mem = raw_mem + 1;
+        mem[EXTRA_BUF_SIZE + TYPE] = NIL_TYPE;
+        mem[EXTRA_BUF_SIZE + SIZE_OR_CLS] = (size_t)cls;
+        mem += EXTRA_BUF_SIZE;
+        // Young object: no GC_OLD_BIT, no hash set insert, no mutex.
+        // Explicitly clear the GC flag word.
+        mem[MARKED_FLAG] = 0;
+        // Zero the object's field words here (zero-on-alloc) instead of relying on a
+        // post-collection memset of the whole nursery. The old design zeroed the
+        // entire used nursery inside the stop-the-world pause (up to nursery-size of
+        // memset on every GC -> a big latency spike for allocation-heavy code). The
+        // total zeroing work is the same, but moving it to the allocator takes it out
+        // of the pause and gives better cache locality (we are about to write the
+        // object anyway). Field bytes = alloc_size - the EXTRA_BUF header words.
+        memset(mem, 0, (size_t)alloc_size - sizeof(size_t) * EXTRA_BUF_SIZE);
+        // release fence: header stores must be visible before this object can be
+        // observed as young (pairs with the acquire load of young_offset in IsYoung).
+        std::atomic_thread_fence(std::memory_order_release);
+        // Accounted per thread; folded into allocation_size when the TLAB retires.
+        tlab.allocated += size;
+        return mem;
       }
     }
 
     // Fallback: old gen allocation
     if(collect && allocation_size + size > mem_max_size) {
-      CollectMajor(op_stack, stack_pos);
+      CollectForOldAllocation(size, op_stack, stack_pos);
+    }
+#ifndef _GC_SERIAL
+    MUTEX_LOCK(&allocated_lock);
+#endif
+    mem = AllocateOld(alloc_size);
+    if(mem) {
+      allocation_size += size;
+      old_allocation_size += size;
     }
-    mem = GetMemory(alloc_size);
+#ifndef _GC_SERIAL
+    MUTEX_UNLOCK(&allocated_lock);
+#endif
     if(!mem) {
       std::wcerr << L">>> Unable to allocate memory of size: " << alloc_size << L" <<<" << std::endl;
       exit(1);
@@ -545,15 +726,8 @@ size_t* MemoryManager::AllocateObject(const long obj_id, size_t* op_stack, size_
     mem[EXTRA_BUF_SIZE + SIZE_OR_CLS] = (size_t)cls;
     mem += EXTRA_BUF_SIZE;
     mem[MARKED_FLAG] |= GC_OLD_BIT;
-#ifndef _GC_SERIAL
-    MUTEX_LOCK(&allocated_lock);
-#endif
-    allocation_size += size;
-    old_allocation_size += size;
-    old_generation.insert(mem);
-#ifndef _GC_SERIAL
-    MUTEX_UNLOCK(&allocated_lock);
-#endif
+    // Born old: start on a dirty card, like object arrays (see AllocateArray)
+    WriteBarrier(mem);
 
 #ifdef _MEM_LOGGING
     mem_logger << mem_cycle << L",alloc,obj," << mem << L"," << size << std::endl;
@@ -568,6 +742,120 @@ size_t* MemoryManager::AllocateObject(const long obj_id, size_t* op_stack, size_
   return mem;
 }
 
+// TLAB slow path: the current chunk cannot fit 'aligned_total' bytes. Small
+// objects retire the chunk and claim a fresh one; large objects take a direct
+// shared bump. Returns nullptr when the nursery is exhausted.
+uint8_t* MemoryManager::RefillAllocBuffer(const size_t aligned_total)
+{
+  ThreadAllocBuffer* buf = &tlab;
+  if(!tlab_registration.registered) {
+#ifndef _GC_SERIAL
+    MUTEX_LOCK(&tlab_lock);
+#endif
+    tlab_buffers.insert(buf);
+#ifndef _GC_SERIAL
+    MUTEX_UNLOCK(&tlab_lock);
+#endif
+    tlab_registration.registered = true;
+  }
+
+  if(aligned_total >= TLAB_DIRECT_MIN) {
+    return AllocateYoungShared(aligned_total);
+  }
+
+  // Claim a full TLAB_SIZE chunk, or what is left of the nursery if that is
+  // smaller but still fits this request. Same commit-only-if-it-fits CAS as
+  // AllocateYoungShared, so young_offset never runs past the region.
+  size_t offset = young_offset.load(std::memory_order_relaxed);
+  size_t chunk;
+  do {
+    const size_t remaining = young_region_size - offset;
+    if(remaining < aligned_total) {
+      return nullptr;
+    }
+    chunk = remaining < TLAB_SIZE ? remaining : TLAB_SIZE;
+  }
+  while(!young_offset.compare_exchange_weak(offset, offset + chunk, std::memory_order_relaxed));
+
+  // Only this thread touches its own buffer outside a collection, and no
+  // safepoint is reached between here and the caller's header stores.
+  RetireAllocBuffer(buf);
+  buf->top = young_region + offset;
+  buf->end = buf->top + chunk;
+
+  uint8_t* raw_mem = buf->top;
+  buf->top += aligned_total;
+  return raw_mem;
+}
+
+// Shared nursery bump. Advance young_offset with a CAS that commits ONLY when the
+// block fits: a plain fetch_add over-advances under concurrency (many threads add
+// past the end without rolling back), leaving young_offset > young_region_size.
+// The collector then uses young_offset as the length of its young walk, running
+// off the end of the mapping -- promoting garbage as objects (corruption).
+uint8_t* MemoryManager::AllocateYoungShared(const size_t aligned_total)
+{
+  size_t offset = young_offset.load(std::memory_order_relaxed);
+  while(offset + aligned_total <= young_region_size) {
+    if(young_offset.compare_exchange_weak(offset, offset + aligned_total, std::memory_order_relaxed)) {
+      return young_region + offset;
+    }
+    // CAS failed: offset was reloaded with the current value — re-test and retry
+  }
+
+  return nullptr;
+}
+
+// Hands a buffer's unused tail back as a gap and folds its pending byte count
+// into allocation_size. Called by the owner (refill, thread exit) or by the
+// collector with the owner parked.
+void MemoryManager::RetireAllocBuffer(ThreadAllocBuffer* buf)
+{
+  FillYoungGap(buf->top, buf->end);
+  buf->top = buf->end = nullptr;
+  if(buf->allocated) {
+    allocation_size.fetch_add(buf->allocated, std::memory_order_relaxed);
+    buf->allocated = 0;
+  }
+}
+
+// Retire every thread's buffer so the nursery walk sees only objects and gaps,
+// and allocation_size is exact. Called once the world is stopped.
+void MemoryManager::RetireAllocBuffers()
+{
+#ifndef _GC_SERIAL
+  MUTEX_LOCK(&tlab_lock);
+#endif
+  for(auto iter = tlab_buffers.begin(); iter != tlab_buffers.end(); ++iter) {
+    RetireAllocBuffer(*iter);
+  }
+#ifndef _GC_SERIAL
+  MUTEX_UNLOCK(&tlab_lock);
+#endif
+}
+
+// Stamps [start, end) as a gap. Blocks are word aligned, so a gap is at least
+// one word: enough for the size word the young walk reads. The body is cleared
+// because it lies below young_offset: stale headers from a previous cycle there
+// would otherwise look like forwarding words to ForwardedAddr's conservative scan.
+void MemoryManager::FillYoungGap(uint8_t* start, uint8_t* end)
+{
+  if(start < end) {
+    const size_t gap = (size_t)(end - start) - sizeof(size_t);
+    *(size_t*)start = YOUNG_FILLER_BIT | gap;
+    memset(start + sizeof(size_t), 0, gap);
+  }
+}
+
+#ifdef _TLAB_JIT_INLINE
+long MemoryManager::AllocBufferTlsOffset()
+{
+  uintptr_t thread_ptr;
+  __asm__("movq %%fs:0, %0" : "=r"(thread_ptr));
+  return (long)((intptr_t)&tlab - (intptr_t)thread_ptr);
+}
+#endif
+
 size_t* MemoryManager::AllocateArray(const size_t size, const MemoryType type, size_t* op_stack, size_t stack_pos, bool collect)
 {
   // Allocation safepoint (see AllocateObject).
@@ -609,9 +897,19 @@ size_t* MemoryManager::AllocateArray(const size_t size, const MemoryType type, s
   // Allocate in old gen (bump allocator disabled — promotion/fixup cannot safely
   // update all root locations including PDA thread operand stacks)
   if(collect && allocation_size + calc_size > mem_max_size) {
-    CollectMajor(op_stack, stack_pos);
+    CollectForOldAllocation(calc_size, op_stack, stack_pos);
+  }
+#ifndef _GC_SERIAL
+  MUTEX_LOCK(&allocated_lock);
+#endif
+  mem = AllocateOld(alloc_size);
+  if(mem) {
+    allocation_size += calc_size;
+    old_allocation_size += calc_size;
   }
-  mem = GetMemory(alloc_size);
+#ifndef _GC_SERIAL
+  MUTEX_UNLOCK(&allocated_lock);
+#endif
   if(!mem) {
     std::wcerr << L">>> Unable to allocate memory of size: " << alloc_size << L" <<<" << std::endl;
     exit(1);
@@ -620,15 +918,12 @@ size_t* MemoryManager::AllocateArray(const size_t size, const MemoryType type, s
   mem[EXTRA_BUF_SIZE + SIZE_OR_CLS] = calc_size;
   mem += EXTRA_BUF_SIZE;
   mem[MARKED_FLAG] |= GC_OLD_BIT;
-#ifndef _GC_SERIAL
-  MUTEX_LOCK(&allocated_lock);
-#endif
-  allocation_size += calc_size;
-  old_allocation_size += calc_size;
-  old_generation.insert(mem);
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&allocated_lock);
-#endif
+  // Object/int arrays start old and are often filled with young objects by native
+  // code that bypasses the write barrier (String->Split, JSON, ...): start them on
+  // a dirty card so the next minor GC scans them
+  if(type == INT_TYPE) {
+    WriteBarrier(mem);
+  }
 
 #ifdef _MEM_LOGGING
   mem_logger << mem_cycle << L",alloc,array," << mem << L"," << size << std::endl;
@@ -642,122 +937,348 @@ size_t* MemoryManager::AllocateArray(const size_t size, const MemoryType type, s
   return mem;
 }
 
-size_t* MemoryManager::GetMemory(size_t size) {
-  size_t* mem = GetFreeMemory(size);
-  if(mem) {
-    return mem;
+// Maps an OLD_PAGE_SIZE aligned run of zeroed pages
+static uint8_t* MapOldRun(size_t run_size)
+{
+#ifdef _WIN32
+  // VirtualAlloc only aligns to 64KB: reserve a padded range to find an aligned
+  // address, then release it and claim the run there. Another thread may take
+  // the address in between, so retry a few times.
+  for(int i = 0; i < 8; ++i) {
+    uint8_t* probe = (uint8_t*)VirtualAlloc(nullptr, run_size + OLD_PAGE_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+    if(!probe) {
+      return nullptr;
+    }
+    uint8_t* run = (uint8_t*)(((uintptr_t)probe + OLD_PAGE_SIZE - 1) & ~(uintptr_t)(OLD_PAGE_SIZE - 1));
+    VirtualFree(probe, 0, MEM_RELEASE);
+    run = (uint8_t*)VirtualAlloc(run, run_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if(run) {
+      return run;
+    }
   }
-
-  size_t alloc_size = size + sizeof(size_t);
-  size_t* raw_mem = (size_t*)calloc(alloc_size, sizeof(char));
-  if(!raw_mem) {
+  return nullptr;
+#else
+  // over-map by one page, then trim the unaligned head and the tail
+  const size_t padded = run_size + OLD_PAGE_SIZE;
+  uint8_t* probe = (uint8_t*)mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(probe == MAP_FAILED) {
     return nullptr;
   }
+  uint8_t* run = (uint8_t*)(((uintptr_t)probe + OLD_PAGE_SIZE - 1) & ~(uintptr_t)(OLD_PAGE_SIZE - 1));
+  if(run > probe) {
+    munmap(probe, run - probe);
+  }
+  uint8_t* run_end = run + run_size;
+  if(probe + padded > run_end) {
+    munmap(run_end, probe + padded - run_end);
+  }
+  return run;
+#endif
+}
 
-#ifdef _DEBUG_GC
-  std::wcout << L"*** Raw allocation: address=" << raw_mem << L" ***" << std::endl;
+static void UnmapOldRun(uint8_t* run, size_t run_size)
+{
+#ifdef _WIN32
+  VirtualFree(run, 0, MEM_RELEASE);
+#else
+  munmap(run, run_size);
 #endif
-  raw_mem[0] = size;
+}
+
+// Returns a zeroed block of 'alloc_size' bytes (plus its size word) in the old
+// generation, or nullptr if the OS is out of memory. Small blocks come from the
+// free list or bump pointer of a page in their size class; large blocks get a
+// run of their own.
+size_t* MemoryManager::AllocateOld(size_t alloc_size)
+{
+  if(alloc_size > ~(size_t)0 - OLD_PAGE_HEADER - 2 * OLD_PAGE_SIZE) {
+    return nullptr;
+  }
+  const size_t block_size = (alloc_size + sizeof(size_t) + OLD_GRANULE - 1) & ~(OLD_GRANULE - 1);
+
+  OldPage* page;
+  uint8_t* cell = nullptr;
+  if(block_size > OLD_SMALL_MAX) {
+    const size_t run_size = (OLD_PAGE_HEADER + block_size + OLD_PAGE_SIZE - 1) & ~(OLD_PAGE_SIZE - 1);
+    page = NewOldPage(block_size, run_size);
+    if(!page) {
+      return nullptr;
+    }
+    // fresh mapping, already zeroed
+    cell = page->bump;
+    page->bump += block_size;
+  }
+  else {
+    const size_t class_id = old_class_index[block_size >> OLD_GRANULE_SHIFT];
+    page = old_partial[class_id];
+    while(page) {
+      if(page->free_list) {
+        cell = (uint8_t*)page->free_list;
+        page->free_list = (size_t*)page->free_list[0];
+        break;
+      }
+      if(page->bump + page->cell_size <= (uint8_t*)page + OLD_PAGE_SIZE) {
+        cell = page->bump;
+        page->bump += page->cell_size;
+        break;
+      }
+      // full: drop it from the class list until a sweep frees a cell
+      old_partial[class_id] = page->next_partial;
+      page = old_partial[class_id];
+    }
+
+    if(!page) {
+      page = NewOldPage(old_class_size[class_id], OLD_PAGE_SIZE);
+      if(!page) {
+        return nullptr;
+      }
+      page->next_partial = old_partial[class_id];
+      old_partial[class_id] = page;
+      cell = page->bump;
+      page->bump += page->cell_size;
+    }
+    memset(cell, 0, page->cell_size);
+  }
+
+  const size_t bit = (size_t)(cell - (uint8_t*)page) >> OLD_GRANULE_SHIFT;
+  page->alloc_bits[bit >> 6] |= (size_t)1 << (bit & 63);
+  page->live_count++;
+  old_object_count++;
+
+  // Born marked while a concurrent cycle runs: the tracer may never reach a cell
+  // that is only stored into objects it has already scanned
+  if(concurrent_cycle.load(std::memory_order_relaxed)) {
+    MarkOldMemory((size_t*)cell + 1 + EXTRA_BUF_SIZE);
+  }
+
+  size_t* raw_mem = (size_t*)cell;
+  raw_mem[0] = alloc_size;
   return raw_mem + 1;
 }
 
-void MemoryManager::AddFreeMemory(size_t* raw_mem) {
-  const size_t size = AlignMemorySize(raw_mem[0]);
-  if(size) {
-    AddFreeCache(size, raw_mem);
+// Takes a page from the empty pool (small pages only) or maps a new run and
+// registers it in the page map
+OldPage* MemoryManager::NewOldPage(size_t cell_size, size_t run_size)
+{
+  OldPage* page;
+  if(run_size == OLD_PAGE_SIZE && !old_empty.empty()) {
+    // swept empty: both bitmaps are already clear, cards may not be
+    page = old_empty.back();
+    old_empty.pop_back();
+    memset(page->cards, 0, sizeof(page->cards));
   }
   else {
-    free(raw_mem);
-    raw_mem = nullptr;
+    page = (OldPage*)MapOldRun(run_size);
+    if(!page) {
+      return nullptr;
+    }
+    page->run_size = run_size;
+    MapOldPage(page, page);
   }
+
+  page->cell_size = cell_size;
+  page->run_size = run_size;
+  page->live_count = 0;
+  page->free_list = nullptr;
+  page->bump = (uint8_t*)page + OLD_PAGE_HEADER;
+  page->next_partial = nullptr;
+  page->has_marks.store(false, std::memory_order_relaxed);
+  page->large = cell_size > OLD_SMALL_MAX;
+  old_pages.push_back(page);
+
+  return page;
 }
 
-void MemoryManager::AddFreeCache(size_t pool, size_t* raw_mem) {
-#ifndef _GC_SERIAL
-  MUTEX_LOCK(&free_memory_cache_lock);
-#endif
-  free_memory_cache_size.fetch_add(raw_mem[0], std::memory_order_relaxed);
+// Points every page-map entry covered by 'page's run at 'owner' (nullptr to remove)
+void MemoryManager::MapOldPage(OldPage* page, OldPage* owner)
+{
+  const uintptr_t first = (uintptr_t)page >> OLD_PAGE_SHIFT;
+  const uintptr_t last = first + (page->run_size >> OLD_PAGE_SHIFT);
+  for(uintptr_t index = first; index < last; ++index) {
+    OldPage**& leaf = old_page_map[index >> OLD_MAP_LEAF_BITS];
+    if(!leaf) {
+      if(!owner) {
+        continue;
+      }
+      leaf = (OldPage**)calloc((size_t)1 << OLD_MAP_LEAF_BITS, sizeof(OldPage*));
+      if(!leaf) {
+        std::wcerr << L">>> Unable to allocate old generation page map <<<" << std::endl;
+        exit(1);
+      }
+    }
+    leaf[index & (((uintptr_t)1 << OLD_MAP_LEAF_BITS) - 1)] = owner;
+  }
+}
 
-  // Push onto the bucket's intrusive list: word [0] holds the block's actual
-  // size (kept), word [1] becomes the next-free link. No node allocation.
-  const size_t idx = PoolIndex(pool);
-  raw_mem[1] = (size_t)free_buckets[idx];
-  free_buckets[idx] = raw_mem;
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&free_memory_cache_lock);
-#endif
+void MemoryManager::FreeOldPage(OldPage* page)
+{
+  MapOldPage(page, nullptr);
+  UnmapOldRun((uint8_t*)page, page->run_size);
 }
 
-size_t* MemoryManager::GetFreeMemory(size_t size) {
-  size_t cache_size = AlignMemorySize(size);
-  if(!cache_size) {
-    return nullptr;
+// Calls 'fn' for every allocated old-gen object, in address order within a page
+template<typename F>
+void MemoryManager::ForEachOldObject(F fn)
+{
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    OldPage* page = old_pages[i];
+    for(size_t w = 0; w < OLD_BITMAP_WORDS; ++w) {
+      size_t bits = page->alloc_bits[w];
+      while(bits) {
+        const size_t bit = w * 64 + LowestBit(bits);
+        bits &= bits - 1;
+        fn((size_t*)((uint8_t*)page + (bit << OLD_GRANULE_SHIFT)) + 1 + EXTRA_BUF_SIZE);
+      }
+    }
   }
+}
 
-#ifndef _GC_SERIAL
-  MUTEX_LOCK(&free_memory_cache_lock);
-#endif
-  // Find first block with actual size >= requested (blocks in the same aligned
-  // bucket may have different actual sizes), unlinking it from the list.
-  const size_t idx = PoolIndex(cache_size);
-  size_t* prev = nullptr;
-  size_t* check_mem = free_buckets[idx];
-  while(check_mem) {
-    size_t* next = (size_t*)check_mem[1];
-    if(check_mem[0] >= size) {
-      if(prev) {
-        prev[1] = (size_t)next;
+// Calls 'fn' for every allocated old-gen object whose header starts on a dirty card
+template<typename F>
+void MemoryManager::ForEachDirtyCardObject(F fn)
+{
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    OldPage* page = old_pages[i];
+    for(size_t card = 0; card < OLD_CARD_COUNT; card += sizeof(uint64_t)) {
+      uint64_t group;
+      memcpy(&group, page->cards + card, sizeof(group));
+      if(!group) {
+        continue;
       }
-      else {
-        free_buckets[idx] = next;
+
+      for(size_t c = card; c < card + sizeof(uint64_t); ++c) {
+        if(!page->cards[c]) {
+          continue;
+        }
+        const size_t first = c * OLD_CARD_GRANULES;
+        size_t bits = (page->alloc_bits[first >> 6] >> (first & 63)) & (((size_t)1 << OLD_CARD_GRANULES) - 1);
+        while(bits) {
+          const size_t bit = first + LowestBit(bits);
+          bits &= bits - 1;
+          fn((size_t*)((uint8_t*)page + (bit << OLD_GRANULE_SHIFT)) + 1 + EXTRA_BUF_SIZE);
+        }
       }
-      free_memory_cache_size.fetch_sub(check_mem[0], std::memory_order_relaxed);
-      memset(check_mem + 1, 0, check_mem[0]);   // also clears the next link
-#ifndef _GC_SERIAL
-      MUTEX_UNLOCK(&free_memory_cache_lock);
-#endif
-      return check_mem + 1;
     }
-    prev = check_mem;
-    check_mem = next;
   }
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&free_memory_cache_lock);
-#endif
+}
 
-  return nullptr;
+// Empties the remembered set: drops GC_RSET_BIT from objects on dirty cards so
+// their next store re-dirties a card, then clears the cards
+void MemoryManager::ClearCards()
+{
+  ForEachDirtyCardObject([](size_t* mem) { mem[MARKED_FLAG] &= ~GC_RSET_BIT; });
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    memset(old_pages[i]->cards, 0, sizeof(old_pages[i]->cards));
+  }
+  remembered_count.store(0, std::memory_order_relaxed);
 }
 
-size_t MemoryManager::AlignMemorySize(size_t size) {
-  --size;
-  size |= size >> 1;
-  size |= size >> 2;
-  size |= size >> 4;
-  size |= size >> 8;
-  size |= size >> 16;
-  size |= size >> 32;
-  ++size;
+// Major GC sweep: frees every allocated-but-unmarked cell, clears the mark
+// bitmaps, returns emptied pages to the pool (unmaps large runs) and rebuilds the
+// per-class lists of pages with room. Returns the number of objects freed.
+size_t MemoryManager::SweepOldSpace()
+{
+  size_t dead_count = 0;
+  memset(old_partial, 0, sizeof(old_partial));
+
+  size_t kept = 0;
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    OldPage* page = old_pages[i];
+    for(size_t w = 0; w < OLD_BITMAP_WORDS; ++w) {
+      size_t dead = page->alloc_bits[w] & ~page->mark_bits[w];
+      while(dead) {
+        const size_t bit = w * 64 + LowestBit(dead);
+        dead &= dead - 1;
+
+        size_t* raw_mem = (size_t*)((uint8_t*)page + (bit << OLD_GRANULE_SHIFT));
+        size_t* mem = raw_mem + 1 + EXTRA_BUF_SIZE;
+        size_t mem_size;
+        if(mem[TYPE] == NIL_TYPE) {
+          StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
+          mem_size = cls ? cls->GetInstanceMemorySize() : mem[SIZE_OR_CLS];
+        }
+        else {
+          mem_size = mem[SIZE_OR_CLS];
+        }
+        allocation_size -= mem_size;
+        old_allocation_size -= mem_size;
+        dead_count++;
+
+#ifdef _DEBUG_GC
+        std::wcout << L"# freeing old memory: addr=" << mem << L"(" << (size_t)mem
+              << L"), size=" << mem_size << L" byte(s) #" << std::endl;
+#endif
+        raw_mem[0] = (size_t)page->free_list;
+        page->free_list = raw_mem;
+        page->live_count--;
+      }
+      page->alloc_bits[w] &= page->mark_bits[w];
+      page->mark_bits[w] = 0;
+    }
+    page->has_marks.store(false, std::memory_order_relaxed);
+
+    if(!page->live_count) {
+      if(page->large) {
+        FreeOldPage(page);
+      }
+      else {
+        old_empty.push_back(page);
+      }
+    }
+    else {
+      if(!page->large && (page->free_list || page->bump + page->cell_size <= (uint8_t*)page + OLD_PAGE_SIZE)) {
+        const size_t class_id = old_class_index[page->cell_size >> OLD_GRANULE_SHIFT];
+        page->next_partial = old_partial[class_id];
+        old_partial[class_id] = page;
+      }
+      old_pages[kept++] = page;
+    }
+  }
+  old_pages.resize(kept);
+  old_object_count -= dead_count;
 
-  return size > ALIGN_POOL_MAX ? 0 : size;
+  return dead_count;
 }
 
-void MemoryManager::ClearFreeMemory() {
-#ifndef _GC_SERIAL
-  MUTEX_LOCK(&free_memory_cache_lock);
-#endif
-  for(size_t i = 0; i < FREE_POOL_COUNT; ++i) {
-    size_t* raw_mem = free_buckets[i];
-    while(raw_mem) {
-      size_t* next = (size_t*)raw_mem[1];
-      free_memory_cache_size.fetch_sub(raw_mem[0], std::memory_order_relaxed);
-      free(raw_mem);
-      raw_mem = next;
+// Minor GC: old objects are marked only to stop tracing, so just clear the
+// bitmaps of pages that saw a mark
+void MemoryManager::ClearOldMarks()
+{
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    OldPage* page = old_pages[i];
+    if(page->has_marks.load(std::memory_order_relaxed)) {
+      memset(page->mark_bits, 0, sizeof(page->mark_bits));
+      page->has_marks.store(false, std::memory_order_relaxed);
     }
-    free_buckets[i] = nullptr;
   }
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&free_memory_cache_lock);
-#endif
+}
+
+void MemoryManager::ReleaseEmptyOldPages()
+{
+  for(size_t i = 0; i < old_empty.size(); ++i) {
+    FreeOldPage(old_empty[i]);
+  }
+  old_empty.clear();
+}
+
+void MemoryManager::ReleaseOldSpace()
+{
+  for(size_t i = 0; i < old_pages.size(); ++i) {
+    UnmapOldRun((uint8_t*)old_pages[i], old_pages[i]->run_size);
+  }
+  old_pages.clear();
+  for(size_t i = 0; i < old_empty.size(); ++i) {
+    UnmapOldRun((uint8_t*)old_empty[i], old_empty[i]->run_size);
+  }
+  old_empty.clear();
+
+  for(size_t i = 0; i < ((size_t)1 << OLD_MAP_ROOT_BITS); ++i) {
+    free(old_page_map[i]);
+    old_page_map[i] = nullptr;
+  }
+  memset(old_partial, 0, sizeof(old_partial));
+  old_object_count = 0;
+  old_allocation_size = 0;
 }
 
 size_t* MemoryManager::ValidObjectCast(size_t* mem, long to_id, long* cls_hierarchy, long** cls_interfaces)
@@ -844,12 +1365,20 @@ void MemoryManager::CollectAllMemory(size_t* op_stack, size_t stack_pos)
   MUTEX_UNLOCK(&stw_lock);
 #endif
 
+  // Every mutator is parked: close out their TLABs before anything walks the nursery.
+  RetireAllocBuffers();
+
   // Major collection mode. Set HERE, under marked_sweep_lock, not in the
   // CollectMajor caller: an unlocked store there could land mid-CollectMinor (which
   // set it true under the lock), flipping that minor sweep to major-mode and
   // freeing live old-gen objects (UAF). Mirrors CollectMinor's locked store.
   minor_gc_mode.store(false, std::memory_order_release);
 
+  // A concurrent cycle in progress: this collection is its remark
+  if(concurrent_cycle.load(std::memory_order_relaxed)) {
+    FinishConcurrentMark();
+  }
+
   CollectionInfo* info = new CollectionInfo;
   info->op_stack = op_stack;
   info->stack_pos = stack_pos;
@@ -876,19 +1405,12 @@ void MemoryManager::CollectAllMemory(size_t* op_stack, size_t stack_pos)
 #endif
 }
 
-#ifdef _WIN32
-unsigned int MemoryManager::CollectMemory(void* arg)
-#else
-void* MemoryManager::CollectMemory(void* arg)
-#endif
+void MemoryManager::CollectMemory(CollectionInfo* info)
 {
 #ifdef _TIMING
   clock_t start = clock();
 #endif
 
-  CollectionInfo* info = (CollectionInfo*)arg;
-  const size_t saved_stack_pos = info->stack_pos;  // Save before CheckStack modifies it
-
   // always-on collection statistics (independent of _MEM_LOGGING / _DEBUG_GC).
   // This is the single choke point for both minor and major collections; the
   // minor_gc_mode flag distinguishes which is running.
@@ -916,88 +1438,12 @@ void* MemoryManager::CollectMemory(void* arg)
   std::wcout << L"## Marking memory ##" << std::endl;
 #endif
 
-#ifndef _GC_SERIAL
-#ifdef _WIN32
-  const int num_threads = 3;
-  HANDLE thread_ids[num_threads];
-
-  thread_ids[0] = (HANDLE)_beginthreadex(nullptr, 0, CheckStatic, info, 0, nullptr);
-  if(!thread_ids[0]) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-
-  thread_ids[1] = (HANDLE)_beginthreadex(nullptr, 0, CheckStack, info, 0, nullptr);
-  if(!thread_ids[1]) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-
-  thread_ids[2] = (HANDLE)_beginthreadex(nullptr, 0, CheckPdaRoots, nullptr, 0, nullptr);
-  if(!thread_ids[2]) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-
-  // join all mark threads
-  if(WaitForMultipleObjects(num_threads, thread_ids, TRUE, INFINITE) != WAIT_OBJECT_0) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
-  }
-
-  for(int i=0; i < num_threads; ++i) {
-    CloseHandle(thread_ids[i]);
-  }
-#else
-  pthread_attr_t attrs;
-  pthread_attr_init(&attrs);
-  pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_JOINABLE);
-  
-  pthread_t static_thread;
-  if(pthread_create(&static_thread, &attrs, CheckStatic, (void*)info)) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-
-  pthread_t stack_thread;
-  if(pthread_create(&stack_thread, &attrs, CheckStack, (void*)info)) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-
-  pthread_t pda_thread;
-  if(pthread_create(&pda_thread, &attrs, CheckPdaRoots, nullptr)) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-  
-  pthread_attr_destroy(&attrs);
-  
-  // join all of the mark threads
-  void *status;
+  MarkParallel(info);
 
-  if(pthread_join(static_thread, &status)) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
+  if(gc_verify && concurrent_remark) {
+    VerifyMarkClosure();
   }
   
-  if(pthread_join(stack_thread, &status)) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
-  }
-
-  if(pthread_join(pda_thread, &status)) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
-  }
-#endif  
-#else
-  CheckStatic(nullptr);
-  CheckStack(info);
-  CheckPdaRoots(nullptr);
-  CheckJitRoots(nullptr);
-#endif
-  
 #ifdef _TIMING
   clock_t end = clock();
   std::wcout << std::dec << L"Mark time: " << (double)(end - start) / CLOCKS_PER_SEC << L" second(s)." << std::endl;
@@ -1009,21 +1455,21 @@ void* MemoryManager::CollectMemory(void* arg)
   std::wcout << L"## Sweeping memory ##" << std::endl;
 #endif
 
-  // Sweep phase: mark threads have already joined, so only allocated_lock
-  // is needed (protects old_generation set from concurrent allocations).
+  // Sweep phase: mark workers have already finished, so only allocated_lock
+  // is needed (protects the old generation pages from concurrent allocations).
   // marked_lock is no longer needed here since MarkMemory uses lock-free CAS.
   //
   // LOCK ORDER: allocated_lock is taken BEFORE pda_monitor_lock here -- the
   // FixupRoots call below acquires the latter while this is held.
-  // CheckPdaRoots takes the two in the opposite order, which is safe ONLY
+  // MarkParallel takes the two in the opposite order, which is safe ONLY
   // because it cannot run concurrently with this sweep:
-  //   - it is a mark thread, joined above before this lock is taken, as is
-  //     the JIT thread it spawns (joined inside it, before it returns);
+  //   - it returns only after every mark worker has reported done, and it
+  //     releases pda_monitor_lock before this lock is taken;
   //   - marked_sweep_lock (CollectAllMemory / CollectMinor) admits one
   //     collector at a time, so no other collection's mark phase overlaps
   //     this sweep either.
   // Break either invariant -- overlap sweep with marking, or call
-  // CheckPdaRoots from outside CollectMemory -- and the two orders become a
+  // MarkParallel from outside CollectMemory -- and the two orders become a
   // live ABBA deadlock that hangs the VM. Coverity reports it as CID 1677214;
   // it is a false positive today only by virtue of the above.
 #ifndef _GC_SERIAL
@@ -1047,6 +1493,13 @@ void* MemoryManager::CollectMemory(void* arg)
   while(scan_ptr < young_region + young_used) {
     size_t* raw_mem = (size_t*)scan_ptr;
     size_t alloc_size = raw_mem[0];
+
+    // Unused tail of a retired TLAB: skip it
+    if(alloc_size & YOUNG_FILLER_BIT) {
+      scan_ptr += sizeof(size_t) + (alloc_size & ~YOUNG_FILLER_BIT);
+      continue;
+    }
+
     size_t total = sizeof(size_t) + alloc_size;
 
     // Alignment: round up total to sizeof(size_t) boundary (matches allocation alignment)
@@ -1066,12 +1519,13 @@ void* MemoryManager::CollectMemory(void* arg)
 
     if(mem[MARKED_FLAG] & GC_MARK_BIT) {
       // Promote to old gen: allocate, copy, store forwarding pointer
-      size_t* new_raw = (size_t*)calloc(total, 1);
-      if(new_raw) {
+      size_t* new_block = AllocateOld(alloc_size);
+      if(new_block) {
+        size_t* new_raw = new_block - 1;
         memcpy(new_raw, raw_mem, total);
         size_t* new_mem = new_raw + 1 + EXTRA_BUF_SIZE;
-        new_mem[MARKED_FLAG] = GC_OLD_BIT | GC_MARK_BIT;  // set old bit + keep mark bit so sweep preserves it
-        old_generation.insert(new_mem);
+        new_mem[MARKED_FLAG] = GC_OLD_BIT;
+        MarkOldMemory(new_mem);  // keep mark so the sweep below preserves it
         old_allocation_size += mem_size;
         promoted_objects.push_back(new_mem);
         promoted_count++;
@@ -1091,71 +1545,30 @@ void* MemoryManager::CollectMemory(void* arg)
 
   // --- Sweep old generation (major GC only) ---
   size_t dead_old_count = 0;
-  [[maybe_unused]] const size_t prev_old_size = old_generation.size();
+  [[maybe_unused]] const size_t prev_old_size = old_object_count;
 
   if(!minor_gc_mode.load(std::memory_order_acquire)) {
-    // Major GC: free dead old-gen objects
-    for(auto iter = old_generation.begin(); iter != old_generation.end(); ) {
-      size_t* mem = *iter;
-      if(mem[MARKED_FLAG] & GC_MARK_BIT) {
-        mem[MARKED_FLAG] &= ~GC_MARK_BIT;
-        ++iter;
-      }
-      else {
-        size_t mem_size;
-        if(mem[TYPE] == NIL_TYPE) {
-          StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
-          mem_size = cls ? cls->GetInstanceMemorySize() : mem[SIZE_OR_CLS];
-        }
-        else {
-          mem_size = mem[SIZE_OR_CLS];
-        }
-        allocation_size -= mem_size;
-        old_allocation_size -= mem_size;
-        dead_old_count++;
-
-        size_t* tmp = mem - EXTRA_BUF_SIZE;
-        AddFreeMemory(tmp - 1);
-
-#ifdef _DEBUG_GC
-        std::wcout << L"# freeing old memory: addr=" << mem << L"(" << (size_t)mem
-              << L"), size=" << mem_size << L" byte(s) #" << std::endl;
-#endif
-        iter = old_generation.erase(iter);
-      }
-    }
+    // Major GC: free dead old-gen objects (linear scan of the page bitmaps)
+    dead_old_count = SweepOldSpace();
   }
   else {
     // Minor GC: just clear mark bits on old objects
-    for(auto iter = old_generation.begin(); iter != old_generation.end(); ++iter) {
-      size_t* mem = *iter;
-      mem[MARKED_FLAG] &= ~GC_MARK_BIT;
-    }
+    ClearOldMarks();
   }
 
   // --- Fixup phase: replace young pointers with forwarded old-gen addresses ---
   if(young_used > 0) {
-    // Fix up roots (use saved_stack_pos since CheckStack decremented info->stack_pos to -1)
-    FixupRoots(info->op_stack, saved_stack_pos);
+    // Fix up roots
+    FixupRoots(info->op_stack, info->stack_pos);
 
     // Fix up old-gen objects
-    size_t dc = dirty_count.load(std::memory_order_relaxed);
-    bool overflow = dc > DIRTY_LIST_MAX;
-
-    if(overflow || !minor_gc_mode.load(std::memory_order_acquire)) {
-      // Overflow or major GC: scan all old-gen objects
-      for(auto iter = old_generation.begin(); iter != old_generation.end(); ++iter) {
-        FixupObject(*iter);
-      }
+    if(!minor_gc_mode.load(std::memory_order_acquire)) {
+      // Major GC: scan all old-gen objects
+      ForEachOldObject(FixupObject);
     }
     else {
-      // Minor GC: only fix up dirty objects + promoted objects
-      for(size_t i = 0; i < dc; ++i) {
-        // Dirty object might have been freed during major sweep — check it's still valid
-        if(dirty_list[i] && old_generation.count(dirty_list[i])) {
-          FixupObject(dirty_list[i]);
-        }
-      }
+      // Minor GC: only objects on dirty cards + promoted objects can hold young refs
+      ForEachDirtyCardObject(FixupObject);
       for(size_t i = 0; i < promoted_objects.size(); ++i) {
         FixupObject(promoted_objects[i]);
       }
@@ -1167,30 +1580,13 @@ void* MemoryManager::CollectMemory(void* arg)
     young_offset.store(0, std::memory_order_relaxed);
   }
 
-  // --- Clear dirty list and RSET bits ---
-  {
-    size_t dc = dirty_count.load(std::memory_order_acquire);
-    if(dc > DIRTY_LIST_MAX) {
-      // Overflow: objects dirtied past DIRTY_LIST_MAX had GC_RSET_BIT set by the
-      // write barrier but were never recorded in dirty_list, so the list-based clear
-      // would miss them and leave a stale rset bit that permanently suppresses their
-      // future write barrier. Clear the bit across all of old gen instead.
-      for(auto iter = old_generation.begin(); iter != old_generation.end(); ++iter) {
-        (*iter)[MARKED_FLAG] &= ~GC_RSET_BIT;
-      }
-      for(size_t i = 0; i < DIRTY_LIST_MAX; ++i) {
-        dirty_list[i] = nullptr;
-      }
-    }
-    else {
-      for(size_t i = 0; i < dc; ++i) {
-        if(dirty_list[i] && old_generation.count(dirty_list[i])) {
-          dirty_list[i][MARKED_FLAG] &= ~GC_RSET_BIT;
-        }
-        dirty_list[i] = nullptr;
-      }
-    }
-    dirty_count.store(0, std::memory_order_release);
+  // --- Clear the card table and RSET bits ---
+  // Every survivor was promoted, so no old->young edge outlives the collection.
+  // A card dirtied by an object the major sweep just freed is cleared here too.
+  ClearCards();
+
+  if(gc_verify && young_used > 0) {
+    VerifyNoYoungRefs();
   }
 
   // Adjust GC constraints based on collection effectiveness. Only major GCs drive
@@ -1222,11 +1618,9 @@ void* MemoryManager::CollectMemory(void* arg)
     }
   }
 
-  // clear free memory cache if oversized. Read unlocked on purpose -- see the
-  // declaration in memory.h; it is a heuristic threshold, and ClearFreeMemory
-  // takes free_memory_cache_lock itself.
-  if(free_memory_cache_size.load(std::memory_order_relaxed) > mem_max_size) {
-    ClearFreeMemory();
+  // return pooled empty pages to the OS once they outgrow the heap threshold
+  if(old_empty.size() * OLD_PAGE_SIZE > mem_max_size) {
+    ReleaseEmptyOldPages();
   }
 
 #ifndef _GC_SERIAL
@@ -1263,16 +1657,315 @@ void* MemoryManager::CollectMemory(void* arg)
     gc_promoted_last.store(promoted_count, std::memory_order_relaxed);
     gc_promoted_total.fetch_add(promoted_count, std::memory_order_relaxed);
     gc_alloc_at_last.store(allocation_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    if(concurrent_remark) {
+      gc_remark_last_us.store(pause_us, std::memory_order_relaxed);
+      if(pause_us > gc_remark_max_us.load(std::memory_order_relaxed)) {
+        gc_remark_max_us.store(pause_us, std::memory_order_relaxed);
+      }
+      gc_concurrent_cycles.fetch_add(1, std::memory_order_relaxed);
+      concurrent_remark = false;
+    }
   }
+}
 
-  return 0;
+// ---- Parallel marking ----
+
+void MemoryManager::StartGcWorkers()
+{
+  gc_workers_started = true;
+  for(long i = 1; i < gc_worker_count; ++i) {
+#ifdef _WIN32
+    HANDLE thread_id = (HANDLE)_beginthreadex(nullptr, 0, GcWorkerMain, &gc_workers[i], 0, nullptr);
+    if(!thread_id) {
+      std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
+      exit(-1);
+    }
+    gc_threads.push_back(thread_id);
+#else
+    pthread_t thread_id;
+    if(pthread_create(&thread_id, nullptr, GcWorkerMain, &gc_workers[i])) {
+      std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
+      exit(-1);
+    }
+    gc_threads.push_back(thread_id);
+#endif
+  }
+}
+
+void MemoryManager::StopGcWorkers()
+{
+  if(!gc_workers_started) {
+    return;
+  }
+
+  MUTEX_LOCK(&gc_pool_lock);
+  gc_workers_stop = true;
+  WAKE_ALL_CONDITION(&gc_start_cv);
+  MUTEX_UNLOCK(&gc_pool_lock);
+
+  for(size_t i = 0; i < gc_threads.size(); ++i) {
+#ifdef _WIN32
+    WaitForSingleObject(gc_threads[i], INFINITE);
+    CloseHandle(gc_threads[i]);
+#else
+    pthread_join(gc_threads[i], nullptr);
+#endif
+  }
+  gc_threads.clear();
+  gc_workers_started = false;
 }
 
 #ifdef _WIN32
-unsigned int MemoryManager::CheckStatic([[maybe_unused]] void* arg)
+unsigned int WINAPI MemoryManager::GcWorkerMain(LPVOID arg)
 #else
-void* MemoryManager::CheckStatic([[maybe_unused]] void* arg)
+void* MemoryManager::GcWorkerMain(void* arg)
+#endif
+{
+  GcWorker* worker = (GcWorker*)arg;
+  gc_worker = worker;
+
+  // Workers are started before the first epoch is published
+  long epoch = 0;
+  while(true) {
+    MUTEX_LOCK(&gc_pool_lock);
+    while(!gc_workers_stop && gc_mark_epoch == epoch) {
+      SLEEP_CONDITION(&gc_start_cv, &gc_pool_lock);
+    }
+    if(gc_workers_stop) {
+      MUTEX_UNLOCK(&gc_pool_lock);
+      break;
+    }
+    epoch = gc_mark_epoch;
+    MUTEX_UNLOCK(&gc_pool_lock);
+
+    RunMarkWorker(worker);
+
+    MUTEX_LOCK(&gc_pool_lock);
+    ++gc_workers_done;
+    WAKE_ALL_CONDITION(&gc_done_cv);
+    MUTEX_UNLOCK(&gc_pool_lock);
+  }
+
+  return 0;
+}
+
+// Mark phase entry: gather the roots into tasks, then mark with every worker.
+// The collecting thread is worker 0, so a single-worker setup never switches
+// threads. Holds pda_monitor_lock until marking ends so no thread can tear down
+// a stack that is still queued for scanning.
+void MemoryManager::MarkParallel(CollectionInfo* info)
+{
+  GatherRootTasks(info);
+
+  gc_worker = &gc_workers[0];
+  if(gc_worker_count > 1) {
+    if(!gc_workers_started) {
+      StartGcWorkers();
+    }
+
+    MUTEX_LOCK(&gc_pool_lock);
+    gc_workers_done = 0;
+    ++gc_mark_epoch;
+    WAKE_ALL_CONDITION(&gc_start_cv);
+    MUTEX_UNLOCK(&gc_pool_lock);
+
+    RunMarkWorker(gc_worker);
+
+    MUTEX_LOCK(&gc_pool_lock);
+    while(gc_workers_done < gc_worker_count - 1) {
+      SLEEP_CONDITION(&gc_done_cv, &gc_pool_lock);
+    }
+    MUTEX_UNLOCK(&gc_pool_lock);
+  }
+  else {
+    RunMarkWorker(gc_worker);
+  }
+
+  ReleaseRootTasks();
+}
+
+// Splits the root set into tasks. Leaves jit_frame_lock and pda_monitor_lock
+// held until ReleaseRootTasks.
+void MemoryManager::GatherRootTasks(CollectionInfo* info)
+{
+  gc_info = info;
+  gc_root_tasks.clear();
+  gc_root_next.store(0, std::memory_order_relaxed);
+
+#ifndef _GC_SERIAL
+  MUTEX_LOCK(&jit_frame_lock);
+#endif
+  GatherPdaRoots();
+
+  gc_root_tasks.push_back({ ROOT_STATIC, 0, 0 });
+  gc_root_tasks.push_back({ ROOT_STACK, 0, 0 });
+  for(size_t i = 0; i < gc_op_stacks.size(); ++i) {
+    gc_root_tasks.push_back({ ROOT_OP_STACK, i, i + 1 });
+  }
+  for(size_t i = 0; i < gc_pda_frames.size(); i += MARK_ROOT_CHUNK) {
+    gc_root_tasks.push_back({ ROOT_PDA_FRAMES, i, std::min(i + MARK_ROOT_CHUNK, gc_pda_frames.size()) });
+  }
+  for(size_t i = 0; i < jit_frames.size(); i += MARK_ROOT_CHUNK) {
+    gc_root_tasks.push_back({ ROOT_JIT_FRAMES, i, std::min(i + MARK_ROOT_CHUNK, jit_frames.size()) });
+  }
+}
+
+void MemoryManager::ReleaseRootTasks()
+{
+  gc_pda_frames.clear();
+  gc_op_stacks.clear();
+  jit_frames.clear();
+#ifndef _GC_SERIAL
+  MUTEX_UNLOCK(&jit_frame_lock);
+  MUTEX_UNLOCK(&pda_monitor_lock);
+#endif
+  gc_info = nullptr;
+}
+
+// Claim root tasks until none are left, then trace and steal until every worker
+// is idle with nothing published. A worker only publishes while active, so once
+// the active count reaches zero an empty shared set stays empty.
+void MemoryManager::RunMarkWorker(GcWorker* worker)
+{
+  gc_active_workers.fetch_add(1, std::memory_order_acq_rel);
+
+  size_t next;
+  while((next = gc_root_next.fetch_add(1, std::memory_order_relaxed)) < gc_root_tasks.size()) {
+    ScanRootTask(gc_root_tasks[next]);
+    DrainMarkStack(worker);
+  }
+
+  while(true) {
+    DrainMarkStack(worker);
+    if(StealMarkWork(worker)) {
+      continue;
+    }
+
+    gc_active_workers.fetch_sub(1, std::memory_order_acq_rel);
+    while(!HasSharedMarkWork()) {
+      if(!gc_active_workers.load(std::memory_order_acquire) && !HasSharedMarkWork()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    gc_active_workers.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+void MemoryManager::ScanRootTask(const GcRootTask& task)
+{
+  switch(task.kind) {
+  case ROOT_STATIC:
+    CheckStatic();
+    break;
+
+  case ROOT_STACK:
+    CheckStack(gc_info->op_stack, gc_info->stack_pos);
+    break;
+
+  case ROOT_OP_STACK:
+    CheckStack(gc_op_stacks[task.start].first, gc_op_stacks[task.start].second);
+    break;
+
+  case ROOT_PDA_FRAMES:
+    for(size_t i = task.start; i < task.end; ++i) {
+      CheckPdaFrame(gc_pda_frames[i]);
+    }
+    break;
+
+  case ROOT_JIT_FRAMES:
+    for(size_t i = task.start; i < task.end; ++i) {
+      CheckJitFrame(jit_frames[i]);
+    }
+    break;
+  }
+}
+
+void MemoryManager::TraceMarkEntry(const MarkEntry& entry)
+{
+  if(entry.dclrs) {
+    CheckMemory(entry.mem, entry.dclrs, entry.dclrs_num, 0);
+  }
+  else {
+    size_t* array = entry.mem;
+    const size_t size = array[0];
+    const size_t dim = array[1];
+    size_t* objects = (size_t*)(array + 2 + dim);
+    for(size_t i = 0; i < size; ++i) {
+      CheckObject((size_t*)objects[i], entry.typed, 2);
+    }
+  }
+}
+
+void MemoryManager::DrainMarkStack(GcWorker* worker)
+{
+  std::vector<MarkEntry>& local = worker->local;
+  while(!local.empty()) {
+    const MarkEntry entry = local.back();
+    local.pop_back();
+    TraceMarkEntry(entry);
+  }
+}
+
+void MemoryManager::PublishMarkWork(GcWorker* worker)
+{
+  std::vector<MarkEntry>& local = worker->local;
+  const size_t keep = local.size() / 2;
+
+#ifndef _GC_SERIAL
+  MUTEX_LOCK(&worker->shared_lock);
 #endif
+  worker->shared.insert(worker->shared.end(), local.begin() + keep, local.end());
+  worker->shared_size.store(worker->shared.size(), std::memory_order_release);
+#ifndef _GC_SERIAL
+  MUTEX_UNLOCK(&worker->shared_lock);
+#endif
+  local.resize(keep);
+}
+
+// Takes half of the first non-empty shared set (all of the thief's own)
+bool MemoryManager::StealMarkWork(GcWorker* thief)
+{
+  const long self = (long)(thief - gc_workers);
+  for(long i = 1; i <= gc_worker_count; ++i) {
+    GcWorker* victim = &gc_workers[(self + i) % gc_worker_count];
+    if(!victim->shared_size.load(std::memory_order_acquire)) {
+      continue;
+    }
+
+#ifndef _GC_SERIAL
+    MUTEX_LOCK(&victim->shared_lock);
+#endif
+    std::vector<MarkEntry>& shared = victim->shared;
+    const size_t take = victim == thief ? shared.size() : (shared.size() + 1) / 2;
+    thief->local.insert(thief->local.end(), shared.end() - take, shared.end());
+    shared.resize(shared.size() - take);
+    victim->shared_size.store(shared.size(), std::memory_order_release);
+#ifndef _GC_SERIAL
+    MUTEX_UNLOCK(&victim->shared_lock);
+#endif
+
+    if(take) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool MemoryManager::HasSharedMarkWork()
+{
+  for(long i = 0; i < gc_worker_count; ++i) {
+    if(gc_workers[i].shared_size.load(std::memory_order_acquire)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void MemoryManager::CheckStatic()
 {
   StackClass** clss = prgm->GetClasses();
   const int cls_num = static_cast<int>(prgm->GetClassNumber());
@@ -1283,21 +1976,15 @@ void* MemoryManager::CheckStatic([[maybe_unused]] void* arg)
   }
 
   // Mark self/param of threads still mid-spawn (raw pointers a child has not yet
-  // installed into its own scannable roots). Piggybacks on this mark thread.
+  // installed into its own scannable roots). Piggybacks on the statics task.
   CheckPendingThreadRoots();
-
-  return 0;
 }
 
-#ifdef _WIN32
-unsigned int MemoryManager::CheckStack(void* arg)
-#else
-void* MemoryManager::CheckStack(void* arg)
-#endif
+// Conservatively marks op_stack[0..stack_pos]
+void MemoryManager::CheckStack(size_t* op_stack, size_t stack_pos)
 {
-  CollectionInfo* info = (CollectionInfo*)arg;
 #ifdef _DEBUG_GC
-  std::wcout << L"----- Marking Stack: stack: pos=" << info->stack_pos 
+  std::wcout << L"----- Marking Stack: stack: pos=" << stack_pos 
 #ifdef _WIN32  
         << L"; thread=" << GetCurrentThread() << L" -----" << std::endl;
 #else
@@ -1305,8 +1992,8 @@ void* MemoryManager::CheckStack(void* arg)
 #endif    
 #endif
 
-  while((int64_t)info->stack_pos > -1) {
-    size_t* check_mem = (size_t*)info->op_stack[info->stack_pos--];
+  for(int64_t i = (int64_t)stack_pos; i > -1; --i) {
+    size_t* check_mem = (size_t*)op_stack[i];
 #ifndef _GC_SERIAL
     MUTEX_LOCK(&allocated_lock);
 #endif
@@ -1318,250 +2005,201 @@ void* MemoryManager::CheckStack(void* arg)
       CheckObject(check_mem, false, 1);
     }
   }
-
-#ifndef _WIN32
-#ifndef _GC_SERIAL
-  pthread_exit(nullptr);
-#endif
-#endif
-    
-  return 0;  
 }
 
-#ifdef _WIN32
-unsigned int MemoryManager::CheckJitRoots([[maybe_unused]] void* arg)
-#else
-void* MemoryManager::CheckJitRoots([[maybe_unused]] void* arg)
-#endif
+void MemoryManager::CheckJitFrame(StackFrame* frame)
 {
-#ifndef _GC_SERIAL
-  MUTEX_LOCK(&jit_frame_lock);
-#endif  
+  StackMethod* method = frame->method;
+  size_t* mem = frame->jit_mem;
+  size_t* self = (size_t*)frame->mem[0];
+  const long dclrs_num = method->GetNumberDeclarations();
 
 #ifdef _DEBUG_GC
-  std::wcout << L"---- Marking JIT method root(s): num=" << jit_frames.size()
-#ifdef _WIN32
-        << L"; thread=" << GetCurrentThread() << L" ------" << std::endl;
-#else
-        << L"; thread=" << pthread_self() << L" ------" << std::endl;
-#endif    
-  std::wcout << L"memory types: " << std::endl;
-#endif
-  
-  for(size_t i = 0; i < jit_frames.size(); ++i) {
-    StackFrame* frame = jit_frames[i];
-    StackMethod* method = frame->method;
-    size_t* mem = frame->jit_mem;
-    size_t* self = (size_t*)frame->mem[0];
-    const long dclrs_num = method->GetNumberDeclarations();
-
-#ifdef _DEBUG_GC
-    std::wcout << L"\t===== JIT method: name=" << method->GetName() << L", id=" << method->GetClass()->GetId()
-      << L"," << method->GetId() << L"; addr=" << method << L"; mem=" << mem << L"; self=" << self
-      << L"; num=" << method->GetNumberDeclarations() << L" =====" << std::endl;
+  std::wcout << L"\t===== JIT method: name=" << method->GetName() << L", id=" << method->GetClass()->GetId()
+    << L"," << method->GetId() << L"; addr=" << method << L"; mem=" << mem << L"; self=" << self
+    << L"; num=" << method->GetNumberDeclarations() << L" =====" << std::endl;
 #endif
 
-    if(mem) {
+  if(mem) {
 #ifdef _ARM64
-      size_t* start = mem - 1;
+    size_t* start = mem - 1;
 #endif
-      
-      // check self
-      if(!method->IsLambda()) {
-        CheckObject(self, true, 1);
-      }
+    
+    // check self
+    if(!method->IsLambda()) {
+      CheckObject(self, true, 1);
+    }
 
-      StackDclr** dclrs = method->GetDeclarations();
+    StackDclr** dclrs = method->GetDeclarations();
 #ifdef _ARM64
-      // front to back...
-      if(method->HasAndOr()) {
-        mem++;
-      }
-      
-      for(int j = 0; j < dclrs_num; ++j) {
+    // front to back...
+    if(method->HasAndOr()) {
+      mem++;
+    }
+    
+    for(int j = 0; j < dclrs_num; ++j) {
 #else
-      // front to back...
-      for(long j = dclrs_num - 1; j >= 0; --j) {
+    // front to back...
+    for(long j = dclrs_num - 1; j >= 0; --j) {
 #endif
-        // update address based upon type
-        switch(dclrs[j]->type) {
-        case FUNC_PARM: {
-          size_t* lambda_mem = (size_t*) * (mem + 1);
-          const size_t mthd_cls_id = *mem;
-          const long virtual_cls_id = (mthd_cls_id >> (16 * (1))) & 0xFFFF;
-          const long mthd_id = (mthd_cls_id >> (16 * (0))) & 0xFFFF;
+      // update address based upon type
+      switch(dclrs[j]->type) {
+      case FUNC_PARM: {
+        size_t* lambda_mem = (size_t*) * (mem + 1);
+        const size_t mthd_cls_id = *mem;
+        const long virtual_cls_id = (mthd_cls_id >> (16 * (1))) & 0xFFFF;
+        const long mthd_id = (mthd_cls_id >> (16 * (0))) & 0xFFFF;
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": FUNC_PARM: id=(" << virtual_cls_id << L"," << mthd_id << L"), mem=" << lambda_mem << std::endl;
+        std::wcout << L"\t" << j << L": FUNC_PARM: id=(" << virtual_cls_id << L"," << mthd_id << L"), mem=" << lambda_mem << std::endl;
 #endif
-          std::pair<int, StackDclr**> closure_dclrs = prgm->GetClass(virtual_cls_id)->GetClosureDeclarations(static_cast<int>(mthd_id));
-          if(MarkMemory(lambda_mem)) {
-            CheckMemory(lambda_mem, closure_dclrs.second, closure_dclrs.first, 1);
-          }
-          // update
-          mem += 2;
+        std::pair<int, StackDclr**> closure_dclrs = prgm->GetClass(virtual_cls_id)->GetClosureDeclarations(static_cast<int>(mthd_id));
+        if(MarkMemory(lambda_mem)) {
+          PushMark(lambda_mem, closure_dclrs.second, closure_dclrs.first, false);
         }
-          break;
+        // update
+        mem += 2;
+      }
+        break;
 
-        case CHAR_PARM:
-        case INT_PARM:
+      case CHAR_PARM:
+      case INT_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": CHAR_PARM/INT_PARM: value=" << (*mem) << std::endl;
+        std::wcout << L"\t" << j << L": CHAR_PARM/INT_PARM: value=" << (*mem) << std::endl;
 #endif
-          // update
-          mem++;
-          break;
+        // update
+        mem++;
+        break;
 
-        case FLOAT_PARM: {
+      case FLOAT_PARM: {
 #ifdef _DEBUG_GC
-          FLOAT_VALUE value;
-          memcpy(&value, mem, sizeof(FLOAT_VALUE));
-          std::wcout << L"\t" << j << L": FLOAT_PARM: value=" << value << std::endl;
+        FLOAT_VALUE value;
+        memcpy(&value, mem, sizeof(FLOAT_VALUE));
+        std::wcout << L"\t" << j << L": FLOAT_PARM: value=" << value << std::endl;
 #endif
-          // update
-          mem++;
-        }
-          break;
+        // update
+        mem++;
+      }
+        break;
 
-        case BYTE_ARY_PARM:
+      case BYTE_ARY_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": BYTE_ARY_PARM: addr=" << (size_t*)(*mem) << L"("
-            << (size_t)(*mem) << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
-            << L" byte(s)" << std::endl;
+        std::wcout << L"\t" << j << L": BYTE_ARY_PARM: addr=" << (size_t*)(*mem) << L"("
+          << (size_t)(*mem) << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
+          << L" byte(s)" << std::endl;
 #endif
-          // mark data
-          MarkMemory((size_t*)(*mem));
-          // update
-          mem++;
-          break;
+        // mark data
+        MarkMemory((size_t*)(*mem));
+        // update
+        mem++;
+        break;
 
-        case CHAR_ARY_PARM:
+      case CHAR_ARY_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": CHAR_ARY_PARM: addr=" << (size_t*)(*mem) << L"(" << (size_t)(*mem)
-            << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
-            << L" byte(s)" << std::endl;
+        std::wcout << L"\t" << j << L": CHAR_ARY_PARM: addr=" << (size_t*)(*mem) << L"(" << (size_t)(*mem)
+          << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
+          << L" byte(s)" << std::endl;
 #endif
-          // mark data
-          MarkMemory((size_t*)(*mem));
-          // update
-          mem++;
-          break;
+        // mark data
+        MarkMemory((size_t*)(*mem));
+        // update
+        mem++;
+        break;
 
-        case INT_ARY_PARM:
+      case INT_ARY_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": INT_ARY_PARM: addr=" << (size_t*)(*mem)
-            << L"(" << (size_t)(*mem) << L"), size="
-            << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
-            << L" byte(s)" << std::endl;
-#endif
-          // mark data
-          MarkMemory((size_t*)(*mem));
-          // update
-          mem++;
-          break;
+        std::wcout << L"\t" << j << L": INT_ARY_PARM: addr=" << (size_t*)(*mem)
+          << L"(" << (size_t)(*mem) << L"), size="
+          << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
+          << L" byte(s)" << std::endl;
+#endif
+        // mark data
+        MarkMemory((size_t*)(*mem));
+        // update
+        mem++;
+        break;
 
-        case FLOAT_ARY_PARM:
+      case FLOAT_ARY_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": FLOAT_ARY_PARM: addr=" << (size_t*)(*mem)
-            << L"(" << (size_t)(*mem) << L"), size=" << L" byte(s)"
-            << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0) << std::endl;
+        std::wcout << L"\t" << j << L": FLOAT_ARY_PARM: addr=" << (size_t*)(*mem)
+          << L"(" << (size_t)(*mem) << L"), size=" << L" byte(s)"
+          << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0) << std::endl;
 #endif
-          // mark data
-          MarkMemory((size_t*)(*mem));
-          // update
-          mem++;
-          break;
+        // mark data
+        MarkMemory((size_t*)(*mem));
+        // update
+        mem++;
+        break;
 
-        case OBJ_PARM: {
+      case OBJ_PARM: {
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": OBJ_PARM: addr=" << (size_t*)(*mem)
-            << L"(" << (size_t)(*mem) << L"), id=";
-          if(*mem) {
-            StackClass* tmp = (StackClass*)((size_t*)(*mem))[SIZE_OR_CLS];
-           std::wcout << L"'" << tmp->GetName() << L"'" << std::endl;
-          }
-          else {
-            std::wcout << L"Unknown" << std::endl;
-          }
-#endif
-          // check object
-          CheckObject((size_t*)(*mem), true, 1);
-          // update
-          mem++;
+        std::wcout << L"\t" << j << L": OBJ_PARM: addr=" << (size_t*)(*mem)
+          << L"(" << (size_t)(*mem) << L"), id=";
+        if(*mem) {
+          StackClass* tmp = (StackClass*)((size_t*)(*mem))[SIZE_OR_CLS];
+         std::wcout << L"'" << tmp->GetName() << L"'" << std::endl;
         }
-          break;
+        else {
+          std::wcout << L"Unknown" << std::endl;
+        }
+#endif
+        // check object
+        CheckObject((size_t*)(*mem), true, 1);
+        // update
+        mem++;
+      }
+        break;
 
-        case OBJ_ARY_PARM:
+      case OBJ_ARY_PARM:
 #ifdef _DEBUG_GC
-          std::wcout << L"\t" << j << L": OBJ_ARY_PARM: addr=" << (size_t*)(*mem) << L"("
-            << (size_t)(*mem) << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
-            << L" byte(s)" << std::endl;
+        std::wcout << L"\t" << j << L": OBJ_ARY_PARM: addr=" << (size_t*)(*mem) << L"("
+          << (size_t)(*mem) << L"), size=" << ((*mem) ? ((size_t*)(*mem))[SIZE_OR_CLS] : 0)
+          << L" byte(s)" << std::endl;
 #endif
-          // mark data
-          if(MarkMemory((size_t*)(*mem))) {
-            size_t* array = (size_t*)(*mem);
-            const size_t size = array[0];
-            const size_t dim = array[1];
-            size_t* objects = (size_t*)(array + 2 + dim);
-            for(size_t k = 0; k < size; ++k) {
-              CheckObject((size_t*)objects[k], true, 2);
-            }
-          }
-          // update
-          mem++;
-          break;
-
-        default:
-          break;
+        // mark data
+        if(MarkMemory((size_t*)(*mem))) {
+          PushMark((size_t*)(*mem), nullptr, 0, true);
         }
+        // update
+        mem++;
+        break;
+
+      default:
+        break;
       }
+    }
 
-      // NOTE: this marks temporary variables that are stored in JIT memory
-      // during some method calls. There are 6 integer temp addresses
+    // NOTE: this marks temporary variables that are stored in JIT memory
+    // during some method calls. There are 6 integer temp addresses
 #ifdef _ARM64
-      mem = start;
-      for(int i = 0; i > -JIT_TMP_LOOK_BACK; --i) {
+    mem = start;
+    for(int i = 0; i > -JIT_TMP_LOOK_BACK; --i) {
 #else
-      for(int i = 0; i < JIT_TMP_LOOK_BACK; ++i) {
+    for(int i = 0; i < JIT_TMP_LOOK_BACK; ++i) {
 #endif
-        size_t* check_mem = (size_t*)mem[i];
+      size_t* check_mem = (size_t*)mem[i];
 #ifndef _GC_SERIAL
-        MUTEX_LOCK(&allocated_lock);
+      MUTEX_LOCK(&allocated_lock);
 #endif 
-        const bool found = IsAllocated(check_mem);
+      const bool found = IsAllocated(check_mem);
 #ifndef _GC_SERIAL
-        MUTEX_UNLOCK(&allocated_lock);
+      MUTEX_UNLOCK(&allocated_lock);
 #endif
-        if(found) {
-          CheckObject(check_mem, false, 1);
-        }
+      if(found) {
+        CheckObject(check_mem, false, 1);
       }
     }
+  }
 #ifdef _DEBUG_GC
-    else {
-      std::wcout << L"\t\t--- Nil memory ---" << std::endl;
-    }
-#endif
+  else {
+    std::wcout << L"\t\t--- Nil memory ---" << std::endl;
   }
-  jit_frames.clear();
-
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&jit_frame_lock);
-#ifndef _WIN32
-  pthread_exit(nullptr);
 #endif
-#endif
-  
-  return 0;
 }
 
-#ifdef _WIN32
-unsigned int MemoryManager::CheckPdaRoots([[maybe_unused]] void* arg)
-#else
-void* MemoryManager::CheckPdaRoots([[maybe_unused]] void* arg)
-#endif
+// Collects every thread's frames and operand stack for the root tasks. Leaves
+// pda_monitor_lock held; MarkParallel releases it once marking is done.
+void MemoryManager::GatherPdaRoots()
 {
-  std::vector<StackFrame*> frames;
-
 #ifndef _GC_SERIAL
   MUTEX_LOCK(&pda_frame_lock);
 #endif
@@ -1580,16 +2218,10 @@ void* MemoryManager::CheckPdaRoots([[maybe_unused]] void* arg)
     StackFrame** frame = *iter;
     if(*frame) {
       if((*frame)->jit_mem) {
-#ifndef _GC_SERIAL
-        MUTEX_LOCK(&jit_frame_lock);
-#endif
         jit_frames.push_back(*frame);
-#ifndef _GC_SERIAL
-        MUTEX_UNLOCK(&jit_frame_lock);
-#endif
       }
       else {
-        frames.push_back(*frame);
+        gc_pda_frames.push_back(*frame);
       }
     }
   }
@@ -1598,10 +2230,10 @@ void* MemoryManager::CheckPdaRoots([[maybe_unused]] void* arg)
 #endif 
   
   // ------
-  // LOCK ORDER: this holds pda_monitor_lock and takes allocated_lock inside the
-  // IsAllocated loop below -- the REVERSE of the collector's sweep, which holds
-  // allocated_lock across its FixupRoots call. That is safe only because this
-  // runs in the mark phase, joined before the sweep begins; see the lock-order
+  // LOCK ORDER: pda_monitor_lock is held through marking, which takes
+  // allocated_lock inside IsAllocated checks -- the REVERSE of the collector's
+  // sweep, which holds allocated_lock across its FixupRoots call. That is safe
+  // only because marking completes before the sweep begins; see the lock-order
   // note at the sweep's allocated_lock in CollectMemory before changing either.
 #ifndef _GC_SERIAL
   MUTEX_LOCK(&pda_monitor_lock);
@@ -1636,135 +2268,66 @@ void* MemoryManager::CheckPdaRoots([[maybe_unused]] void* arg)
       StackFrame* cur_frame = *(monitor->cur_frame);
 
       if(cur_frame->jit_mem) {
-#ifndef _GC_SERIAL
-        MUTEX_LOCK(&jit_frame_lock);
-#endif
         jit_frames.push_back(cur_frame);
-#ifndef _GC_SERIAL
-        MUTEX_UNLOCK(&jit_frame_lock);
-#endif
       }
       else {
-        frames.push_back(cur_frame);
+        gc_pda_frames.push_back(cur_frame);
       }
 
       // copy frames locally
       while(--call_stack_pos > -1) {
         StackFrame* frame = call_stack[call_stack_pos];
         if(frame && frame->jit_mem) {
-#ifndef _GC_SERIAL
-          MUTEX_LOCK(&jit_frame_lock);
-#endif
           jit_frames.push_back(frame);
-#ifndef _GC_SERIAL
-          MUTEX_UNLOCK(&jit_frame_lock);
-#endif
         }
         else if(frame) {
-          frames.push_back(frame);
+          gc_pda_frames.push_back(frame);
         }
       }
     }
 
-    // Mark THIS thread's operand stack. CheckStack only marks the GC-triggering
-    // thread's op_stack (info->op_stack), but FixupRoots later relocates refs in
-    // EVERY monitor's op_stack. That asymmetry meant an object live solely via a
-    // PARKED thread's op_stack slot (a transient mid-expression, not yet stored to
-    // a frame local) went unmarked -> swept -> fixup then chased a dangling pointer.
-    // Mark exactly the slots fixup will touch, for every thread. (Re-marking the
-    // triggering thread's stack here is harmless — CheckObject is idempotent.)
+    // Queue THIS thread's operand stack. The ROOT_STACK task only marks the
+    // GC-triggering thread's op_stack (info->op_stack), but FixupRoots later
+    // relocates refs in EVERY monitor's op_stack. That asymmetry meant an object
+    // live solely via a PARKED thread's op_stack slot (a transient mid-expression,
+    // not yet stored to a frame local) went unmarked -> swept -> fixup then chased
+    // a dangling pointer. Mark exactly the slots fixup will touch, for every
+    // thread. (Re-marking the triggering thread's stack is harmless — CheckObject
+    // is idempotent.)
     size_t* mon_op_stack = monitor->op_stack;
     size_t* mon_stack_pos = monitor->stack_pos;
     if(mon_op_stack && mon_stack_pos) {
       const size_t pos = *mon_stack_pos;
       std::atomic_thread_fence(std::memory_order_acquire);
-      for(size_t i = 0; i <= pos; ++i) {
-        size_t* check_mem = (size_t*)mon_op_stack[i];
-#ifndef _GC_SERIAL
-        MUTEX_LOCK(&allocated_lock);
-#endif
-        const bool found = IsAllocated(check_mem);
-#ifndef _GC_SERIAL
-        MUTEX_UNLOCK(&allocated_lock);
-#endif
-        if(found) {
-          CheckObject(check_mem, false, 1);
-        }
-      }
+      gc_op_stacks.push_back(std::make_pair(mon_op_stack, pos));
     }
   }
+}
 
-#ifndef _GC_SERIAL
-  MUTEX_UNLOCK(&pda_monitor_lock);
-#endif
-
-  // check JIT roots in separate thread
-#ifndef _GC_SERIAL
-#ifdef _WIN32
-  HANDLE thread_id = (HANDLE)_beginthreadex(nullptr, 0, CheckJitRoots, nullptr, 0, nullptr);
-  if(!thread_id) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-#else
-  pthread_attr_t attrs;
-  pthread_attr_init(&attrs);
-  pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_JOINABLE);
-  
-  pthread_t jit_thread;
-  if(pthread_create(&jit_thread, &attrs, CheckJitRoots, nullptr)) {
-    std::wcerr << L"Unable to create garbage collection thread!" << std::endl;
-    exit(-1);
-  }
-#endif
-#endif
-
-  // check PDA roots
-  for(size_t i = 0; i < frames.size(); ++i) {
-    StackFrame* frame = frames[i];
-    StackMethod* method = frame->method;
-    size_t* mem = frame->mem;
+void MemoryManager::CheckPdaFrame(StackFrame* frame)
+{
+  StackMethod* method = frame->method;
+  size_t* mem = frame->mem;
 
 #ifdef _DEBUG_GC
-    std::wcout << L"\t===== PDA method: name=" << method->GetName() << L", addr="
-      << method << L", num=" << method->GetNumberDeclarations() << L" =====" << std::endl;
+  std::wcout << L"\t===== PDA method: name=" << method->GetName() << L", addr="
+    << method << L", num=" << method->GetNumberDeclarations() << L" =====" << std::endl;
 #endif
 
-    // mark self
-    if(!method->IsLambda()) {
-      CheckObject((size_t*)(*mem), true, 1);
-    }
-
-    if(method->HasAndOr()) {
-      mem += 2;
-    }
-    else {
-      mem++;
-    }
-
-    // mark rest of memory
-    CheckMemory(mem, method->GetDeclarations(), method->GetNumberDeclarations(), 0);
+  // mark self
+  if(!method->IsLambda()) {
+    CheckObject((size_t*)(*mem), true, 1);
   }
 
-#ifndef _GC_SERIAL
-#ifdef _WIN32
-  // wait for JIT thread
-  if(WaitForSingleObject(thread_id, INFINITE) != WAIT_OBJECT_0) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
+  if(method->HasAndOr()) {
+    mem += 2;
   }
-  CloseHandle(thread_id);
-#else
-  void *status;
-  if(pthread_join(jit_thread, &status)) {
-    std::wcerr << L"Unable to join garbage collection threads!" << std::endl;
-    exit(-1);
+  else {
+    mem++;
   }
-  pthread_exit(nullptr);
-#endif
-#endif
 
-  return 0;
+  // mark rest of memory
+  CheckMemory(mem, method->GetDeclarations(), method->GetNumberDeclarations(), 0);
 }
 
 void MemoryManager::CheckMemory(size_t* mem, StackDclr** dclrs, const long dcls_size, long depth)
@@ -1788,8 +2351,8 @@ void MemoryManager::CheckMemory(size_t* mem, StackDclr** dclrs, const long dcls_
       std::wcout << L"\t" << i << L": FUNC_PARM: id=(" << virtual_cls_id << L"," << mthd_id << L"), mem=" << lambda_mem << std::endl;
 #endif
       std::pair<int, StackDclr**> closure_dclrs = prgm->GetClass(virtual_cls_id)->GetClosureDeclarations(static_cast<int>(mthd_id));
-      if(MarkMemory(lambda_mem)) {
-        CheckMemory(lambda_mem, closure_dclrs.second, closure_dclrs.first, depth + 1);
+      if(!IsConcurrentSkip(lambda_mem) && MarkMemory(lambda_mem)) {
+        PushMark(lambda_mem, closure_dclrs.second, closure_dclrs.first, false);
       }
       // update
       mem += 2;
@@ -1890,13 +2453,7 @@ void MemoryManager::CheckMemory(size_t* mem, StackDclr** dclrs, const long dcls_
 #endif
       // mark data
       if(MarkMemory((size_t*)(*mem))) {
-        size_t* array = (size_t*)(*mem);
-        const size_t size = array[0];
-        const size_t dim = array[1];
-        size_t* objects = (size_t*)(array + 2 + dim);
-        for(size_t k = 0; k < size; ++k) {
-          CheckObject((size_t*)objects[k], true, 2);
-        }
+        PushMark((size_t*)(*mem), nullptr, 0, true);
       }
       // update
       mem++;
@@ -1948,12 +2505,7 @@ void MemoryManager::ScanDirtyObject(size_t* mem)
         if(ref && IsYoung(ref)) {
           if(MarkMemory(ref)) {
             if(ref[TYPE] == INT_TYPE || ref[TYPE] == NIL_TYPE) {
-              size_t size = ref[0];
-              size_t dim = ref[1];
-              size_t* objects = ref + 2 + dim;
-              for(size_t k = 0; k < size; ++k) {
-                CheckObject((size_t*)objects[k], false, 1);
-              }
+              PushMark(ref, nullptr, 0, false);
             }
           }
         }
@@ -1979,6 +2531,189 @@ void MemoryManager::ScanDirtyObject(size_t* mem)
   }
 }
 
+// ---- Generational GC: verification (gc-verify / gc-stress) ----
+
+// True if the card holding old object 'mem's header is dirty
+static inline bool IsCardDirty(size_t* mem)
+{
+  const uintptr_t raw = (uintptr_t)mem - sizeof(size_t) * (EXTRA_BUF_SIZE + 1);
+  OldPage* page = (OldPage*)(raw & ~(OLD_PAGE_SIZE - 1));
+  return page->cards[(raw - (uintptr_t)page) >> OLD_CARD_SHIFT] != 0;
+}
+
+// True if old object 'mem' is set in its page's mark bitmap
+static inline bool IsOldMarked(size_t* mem)
+{
+  const uintptr_t raw = (uintptr_t)mem - sizeof(size_t) * (EXTRA_BUF_SIZE + 1);
+  OldPage* page = (OldPage*)(raw & ~(OLD_PAGE_SIZE - 1));
+  const size_t bit = (raw - (uintptr_t)page) >> OLD_GRANULE_SHIFT;
+  return (page->mark_bits[bit >> 6] >> (bit & 63)) & 1;
+}
+
+void MemoryManager::VerifyFailed(size_t* holder, size_t* ref, const wchar_t* what)
+{
+  std::wcerr << L">>> GC verify: " << what << L": holder=" << holder << L", ref=" << ref;
+  StackClass* cls = holder[TYPE] == NIL_TYPE ? (StackClass*)holder[SIZE_OR_CLS] : nullptr;
+  if(cls) {
+    std::wcerr << L", class='" << cls->GetName() << L"'";
+  }
+  std::wcerr << L" <<<" << std::endl;
+  exit(1);
+}
+
+// Before a minor GC: every old object holding a young reference must sit on a
+// dirty card, or the minor GC would miss that edge and free a live object
+void MemoryManager::VerifyCardTable()
+{
+  ForEachOldObject([](size_t* mem) {
+    if(IsCardDirty(mem)) {
+      return;
+    }
+
+    if(mem[TYPE] == NIL_TYPE) {
+      StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
+      if(!cls) {
+        return;
+      }
+      StackDclr** dclrs = cls->GetInstanceDeclarations();
+      const long num_dclrs = cls->GetNumberInstanceDeclarations();
+      size_t* field_ptr = mem;
+      for(long i = 0; i < num_dclrs; ++i) {
+        size_t* ref = nullptr;
+        switch(dclrs[i]->type) {
+        case FUNC_PARM:
+          ref = (size_t*)*(field_ptr + 1);
+          field_ptr += 2;
+          break;
+
+        case OBJ_PARM:
+        case OBJ_ARY_PARM:
+        case BYTE_ARY_PARM:
+        case CHAR_ARY_PARM:
+        case INT_ARY_PARM:
+        case FLOAT_ARY_PARM:
+          ref = (size_t*)(*field_ptr);
+          field_ptr++;
+          break;
+
+        default:
+          field_ptr++;
+          break;
+        }
+        if(ref && IsYoung(ref)) {
+          VerifyFailed(mem, ref, L"old->young edge on a clean card");
+        }
+      }
+    }
+    else if(mem[TYPE] == INT_TYPE) {
+      const size_t size = mem[0];
+      const size_t dim = mem[1];
+      size_t* objects = mem + 2 + dim;
+      for(size_t k = 0; k < size; ++k) {
+        size_t* ref = (size_t*)objects[k];
+        if(ref && IsYoung(ref)) {
+          VerifyFailed(mem, ref, L"old->young array edge on a clean card");
+        }
+      }
+    }
+  });
+}
+
+// After a collection: the nursery has been reset, so no typed field of an old
+// object may still point into it. (Int/object array elements are untyped words
+// and are not checked here.)
+void MemoryManager::VerifyNoYoungRefs()
+{
+  ForEachOldObject([](size_t* mem) {
+    if(mem[TYPE] != NIL_TYPE) {
+      return;
+    }
+    StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
+    if(!cls) {
+      return;
+    }
+
+    StackDclr** dclrs = cls->GetInstanceDeclarations();
+    const long num_dclrs = cls->GetNumberInstanceDeclarations();
+    size_t* field_ptr = mem;
+    for(long i = 0; i < num_dclrs; ++i) {
+      size_t* ref = nullptr;
+      switch(dclrs[i]->type) {
+      case FUNC_PARM:
+        ref = (size_t*)*(field_ptr + 1);
+        field_ptr += 2;
+        break;
+
+      case OBJ_PARM:
+      case OBJ_ARY_PARM:
+      case BYTE_ARY_PARM:
+      case CHAR_ARY_PARM:
+      case INT_ARY_PARM:
+      case FLOAT_ARY_PARM:
+        ref = (size_t*)(*field_ptr);
+        field_ptr++;
+        break;
+
+      default:
+        field_ptr++;
+        break;
+      }
+      if((uint8_t*)ref >= young_region && (uint8_t*)ref < young_region + young_region_size) {
+        VerifyFailed(mem, ref, L"old object still references the nursery");
+      }
+    }
+  });
+}
+
+// After a remark's mark phase: a marked old object may not reference an unmarked
+// one through a typed field, or the sweep would free it. Checks what the
+// incremental-update barrier and the dirty-card rescan promise.
+void MemoryManager::VerifyMarkClosure()
+{
+  ForEachOldObject([](size_t* mem) {
+    if(mem[TYPE] != NIL_TYPE || !IsOldMarked(mem)) {
+      return;
+    }
+    StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
+    if(!cls) {
+      return;
+    }
+
+    StackDclr** dclrs = cls->GetInstanceDeclarations();
+    const long num_dclrs = cls->GetNumberInstanceDeclarations();
+    size_t* field_ptr = mem;
+    for(long i = 0; i < num_dclrs; ++i) {
+      size_t* ref = nullptr;
+      switch(dclrs[i]->type) {
+      case FUNC_PARM:
+        ref = (size_t*)*(field_ptr + 1);
+        field_ptr += 2;
+        break;
+
+      case OBJ_PARM:
+      case OBJ_ARY_PARM:
+      case BYTE_ARY_PARM:
+      case CHAR_ARY_PARM:
+      case INT_ARY_PARM:
+      case FLOAT_ARY_PARM:
+        ref = (size_t*)(*field_ptr);
+        field_ptr++;
+        break;
+
+      default:
+        field_ptr++;
+        break;
+      }
+      if(!ref) {
+        continue;
+      }
+      if(IsYoung(ref) ? !(ref[MARKED_FLAG] & GC_MARK_BIT) : (IsOldAllocated(ref) && !IsOldMarked(ref))) {
+        VerifyFailed(mem, ref, L"marked object references an unmarked one");
+      }
+    }
+  });
+}
+
 // ---- Fixup functions: replace young pointers with forwarded old-gen addresses ----
 
 void MemoryManager::FixupMemory(size_t* mem, StackDclr** dclrs, const long dcls_size)
@@ -2327,27 +3062,31 @@ void MemoryManager::CollectMinor(size_t* op_stack, size_t stack_pos)
 
 #ifdef _DEBUG_GC
   std::wcout << L"=== Minor GC: young_offset=" << young_offset.load(std::memory_order_relaxed)
-        << L", old_count=" << old_generation.size()
-        << L", dirty_count=" << dirty_count.load(std::memory_order_relaxed)
+        << L", old_count=" << old_object_count
+        << L", remembered=" << remembered_count.load(std::memory_order_relaxed)
         << L" ===" << std::endl;
 #endif
 
-  // Phase 1: Scan dirty old-gen objects for young references (with minor_gc_mode=true)
-  minor_gc_mode.store(true, std::memory_order_release);
+  // Every mutator is parked: close out their TLABs before anything walks the nursery.
+  RetireAllocBuffers();
 
-  size_t dc = dirty_count.load(std::memory_order_relaxed);
-  bool overflow = dc > DIRTY_LIST_MAX;
-
-  if(overflow) {
-    // Dirty list overflowed — scan all old-gen objects
-    for(auto iter = old_generation.begin(); iter != old_generation.end(); ++iter) {
-      ScanDirtyObject(*iter);
-    }
+  // A concurrent cycle owns the card table until its remark, so a collection
+  // requested meanwhile finishes the cycle as a major GC instead
+  const bool remark = concurrent_cycle.load(std::memory_order_relaxed);
+  if(remark) {
+    minor_gc_mode.store(false, std::memory_order_release);
+    FinishConcurrentMark();
   }
   else {
-    for(size_t i = 0; i < dc; ++i) {
-      ScanDirtyObject(dirty_list[i]);
+    // Phase 1: Scan dirty old-gen objects for young references (with minor_gc_mode=true).
+    // Young objects reached here are queued on worker 0 and traced by MarkParallel.
+    minor_gc_mode.store(true, std::memory_order_release);
+    gc_worker = &gc_workers[0];
+
+    if(gc_verify) {
+      VerifyCardTable();
     }
+    ForEachDirtyCardObject(ScanDirtyObject);
   }
 
   // Phase 2: Mark from roots + sweep (promote-all + fixup + reset)
@@ -2357,6 +3096,12 @@ void MemoryManager::CollectMinor(size_t* op_stack, size_t stack_pos)
 
   CollectMemory(info);
 
+  // Old generation nearing the major threshold: begin a concurrent cycle while the
+  // world is still stopped and the nursery is empty
+  if(gc_concurrent && !remark && old_allocation_size > mem_max_size / 100 * CONCURRENT_START_PERCENT) {
+    StartConcurrentMark(info);
+  }
+
 #ifndef _GC_SERIAL
   // Resume the world.
   MUTEX_LOCK(&stw_lock);
@@ -2368,13 +3113,31 @@ void MemoryManager::CollectMinor(size_t* op_stack, size_t stack_pos)
 #endif
 
 #ifdef _DEBUG_GC
-  std::wcout << L"=== Minor GC complete: old_count=" << old_generation.size() << L" ===" << std::endl;
+  std::wcout << L"=== Minor GC complete: old_count=" << old_object_count << L" ===" << std::endl;
 #endif
 
   delete info;
   info = nullptr;
 }
 
+// An old-generation allocation of 'size' bytes would pass the heap threshold.
+// Normally a major GC; with 'gc-concurrent', a minor GC that starts a concurrent
+// cycle, then the remark once the tracer is done or another threshold's worth
+// has been allocated since the initial mark. Meanwhile the allocation proceeds.
+void MemoryManager::CollectForOldAllocation(size_t size, size_t* op_stack, size_t stack_pos)
+{
+  if(!gc_concurrent) {
+    CollectMajor(op_stack, stack_pos);
+  }
+  else if(!concurrent_cycle.load(std::memory_order_relaxed)) {
+    CollectMinor(op_stack, stack_pos);
+  }
+  else if(concurrent_done.load(std::memory_order_acquire) ||
+          allocation_size + size > concurrent_start_size + mem_max_size) {
+    CollectMajor(op_stack, stack_pos);
+  }
+}
+
 void MemoryManager::CollectMajor(size_t* op_stack, size_t stack_pos)
 {
   // NOTE: minor_gc_mode is set to false INSIDE CollectAllMemory (under
@@ -2392,6 +3155,134 @@ void MemoryManager::JitWriteBarrier(size_t* target_obj)
   WriteBarrier(target_obj);
 }
 
+// ---- Concurrent marking ----
+
+// Initial mark, run by a minor GC's collector before it resumes the world. Every
+// survivor was just promoted, so the roots only reach old objects: mark those,
+// then hand their fields to the tracer thread.
+void MemoryManager::StartConcurrentMark(CollectionInfo* info)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  // the minor GC left minor mode on, which would mark roots without tracing them
+  minor_gc_mode.store(false, std::memory_order_release);
+  concurrent_start_size = allocation_size.load(std::memory_order_relaxed);
+  concurrent_cycle.store(true, std::memory_order_relaxed);
+  concurrent_mark.store(true, std::memory_order_release);
+  concurrent_abort.store(false, std::memory_order_relaxed);
+  concurrent_done.store(false, std::memory_order_relaxed);
+
+  gc_worker = &gc_workers[0];
+  GatherRootTasks(info);
+  for(size_t i = 0; i < gc_root_tasks.size(); ++i) {
+    ScanRootTask(gc_root_tasks[i]);
+  }
+  ReleaseRootTasks();
+
+#ifdef _WIN32
+  concurrent_thread = (HANDLE)_beginthreadex(nullptr, 0, ConcurrentMarkMain, nullptr, 0, nullptr);
+  concurrent_thread_live = concurrent_thread != nullptr;
+#else
+  concurrent_thread_live = !pthread_create(&concurrent_thread, nullptr, ConcurrentMarkMain, nullptr);
+#endif
+  // without a tracer the remark simply does all of the marking
+
+  const long pause_us = (long)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  gc_initial_mark_last_us.store(pause_us, std::memory_order_relaxed);
+  if(pause_us > gc_initial_mark_max_us.load(std::memory_order_relaxed)) {
+    gc_initial_mark_max_us.store(pause_us, std::memory_order_relaxed);
+  }
+}
+
+// Remark preparation, under stop-the-world: stop the tracer, then queue the
+// fields of marked objects on dirty cards. A store into an object the tracer had
+// already scanned dirtied its card (incremental update), and no minor GC has
+// cleared a card since the initial mark, so every edge the tracer missed is on a
+// dirty card, in the nursery, or in a root. The collection that follows traces
+// all three, stopping at objects the tracer marked.
+void MemoryManager::FinishConcurrentMark()
+{
+  StopConcurrentMark();
+  if(!concurrent_done.load(std::memory_order_acquire)) {
+    gc_concurrent_incomplete.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  concurrent_mark.store(false, std::memory_order_release);
+  concurrent_cycle.store(false, std::memory_order_relaxed);
+  concurrent_remark = true;
+
+  // unfinished tracer work stays on worker 0 for the remark to drain
+  gc_worker = &gc_workers[0];
+  ForEachDirtyCardObject(RescanMarkedObject);
+}
+
+void MemoryManager::StopConcurrentMark()
+{
+  if(!concurrent_thread_live) {
+    return;
+  }
+
+  concurrent_abort.store(true, std::memory_order_release);
+#ifdef _WIN32
+  WaitForSingleObject(concurrent_thread, INFINITE);
+  CloseHandle(concurrent_thread);
+#else
+  pthread_join(concurrent_thread, nullptr);
+#endif
+  concurrent_thread_live = false;
+}
+
+void MemoryManager::RescanMarkedObject(size_t* mem)
+{
+  if(!IsOldMarked(mem)) {
+    return;
+  }
+
+  if(mem[TYPE] == NIL_TYPE) {
+    StackClass* cls = (StackClass*)mem[SIZE_OR_CLS];
+    if(cls) {
+      PushMark(mem, cls->GetInstanceDeclarations(), cls->GetNumberInstanceDeclarations(), false);
+    }
+  }
+  else if(mem[TYPE] == INT_TYPE) {
+    PushMark(mem, nullptr, 0, false);
+  }
+}
+
+// Tracer thread: drains worker 0's mark stack while mutators run. Old objects
+// are not moved or freed until the remark, which joins this thread first.
+#ifdef _WIN32
+unsigned int WINAPI MemoryManager::ConcurrentMarkMain(LPVOID arg)
+#else
+void* MemoryManager::ConcurrentMarkMain(void* arg)
+#endif
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  GcWorker* worker = &gc_workers[0];
+  gc_worker = worker;
+
+  std::vector<MarkEntry>& local = worker->local;
+  for(size_t traced = 0; ; ++traced) {
+    if(!(traced % CONCURRENT_POLL_ENTRIES) && concurrent_abort.load(std::memory_order_acquire)) {
+      break;
+    }
+    if(local.empty() && !StealMarkWork(worker)) {
+      concurrent_done.store(true, std::memory_order_release);
+      break;
+    }
+
+    const MarkEntry entry = local.back();
+    local.pop_back();
+    TraceMarkEntry(entry);
+  }
+
+  gc_concurrent_mark_last_us.store((long)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+
+  return 0;
+}
+
 // ---- End Generational GC ----
 
 void MemoryManager::CheckObject(size_t* mem, bool is_obj, long depth)
@@ -2409,6 +3300,10 @@ void MemoryManager::CheckObject(size_t* mem, bool is_obj, long depth)
       MarkMemory(mem);
       return;
     }
+    // Concurrent trace: the nursery changes under the tracer; the remark covers it
+    if(IsConcurrentSkip(mem)) {
+      return;
+    }
     StackClass* cls;
     if(is_obj) {
       cls = GetClass(mem);
@@ -2428,7 +3323,7 @@ void MemoryManager::CheckObject(size_t* mem, bool is_obj, long depth)
 
       // mark data
       if(MarkMemory(mem)) {
-        CheckMemory(mem, cls->GetInstanceDeclarations(), cls->GetNumberInstanceDeclarations(), depth);
+        PushMark(mem, cls->GetInstanceDeclarations(), cls->GetNumberInstanceDeclarations(), false);
       }
     } 
     else {
@@ -2448,13 +3343,7 @@ void MemoryManager::CheckObject(size_t* mem, bool is_obj, long depth)
       if(MarkMemory(mem)) {
         // ensure we're only checking int and obj arrays
         if(mem[TYPE] == NIL_TYPE || mem[TYPE] == INT_TYPE) {
-            size_t* array = mem;
-            const size_t size = array[0];
-            const size_t dim = array[1];
-            size_t* objects = (size_t*)(array + 2 + dim);
-            for(size_t i = 0; i < size; ++i) {
-              CheckObject((size_t*)objects[i], false, 2);
-            }
+          PushMark(mem, nullptr, 0, false);
         }
       }
     }
@@ -35,6 +35,7 @@
 #include "../common.h"
 #include <random>
 #include <atomic>
+#include <thread>
 #ifndef _WIN32
 #include <sys/mman.h>
 #endif
@@ -57,19 +58,84 @@
 
 #define JIT_TMP_LOOK_BACK 16
 
-#define ALIGN_POOL_MAX (1 << 22)
+// Old generation: size-class segregated pages. Blocks up to OLD_SMALL_MAX bytes
+// (size word included) live in OLD_PAGE_SIZE pages of same-sized cells; larger
+// ones get a dedicated run of pages. Runs are OLD_PAGE_SIZE aligned, so an object
+// finds its page header by masking, and each page keeps side bitmaps with one
+// allocated bit and one mark bit per OLD_GRANULE bytes.
+#define OLD_PAGE_SHIFT     18
+#define OLD_PAGE_SIZE      ((size_t)1 << OLD_PAGE_SHIFT)        // 256KB
+#define OLD_GRANULE_SHIFT  4
+#define OLD_GRANULE        ((size_t)1 << OLD_GRANULE_SHIFT)     // 16 bytes
+#define OLD_BITMAP_WORDS   (OLD_PAGE_SIZE / OLD_GRANULE / 64)
+#define OLD_SMALL_MAX      (16 * 1024)
+#define OLD_CLASS_MAX      48                                   // bound on size-class count
+
+// Page map: two-level radix table over (address >> OLD_PAGE_SHIFT) for a 48-bit
+// address space. Membership tests go through it, so a stray word never causes a
+// read of memory the old generation does not own.
+#define OLD_MAP_LEAF_BITS  15
+#define OLD_MAP_ROOT_BITS  (48 - OLD_PAGE_SHIFT - OLD_MAP_LEAF_BITS)
+
+// Card table (remembered set): one byte per OLD_CARD_SIZE bytes of each old page,
+// dirtied by the write barrier for the card holding the stored-into object's
+// header. A minor GC scans only objects that start on dirty cards, so the set
+// never overflows and costs a fixed OLD_CARD_COUNT bytes per page.
+#define OLD_CARD_SHIFT     9
+#define OLD_CARD_SIZE      ((size_t)1 << OLD_CARD_SHIFT)        // 512 bytes
+#define OLD_CARD_COUNT     (OLD_PAGE_SIZE / OLD_CARD_SIZE)
+#define OLD_CARD_GRANULES  (OLD_CARD_SIZE / OLD_GRANULE)        // alloc bits per card
 
 // Generational GC: bit-packing in MARKED_FLAG slot
-// Bit 0:    Mark bit (existing)
+// Bit 0:    Mark bit (young objects; old objects use their page's mark bitmap)
 // Bit 1:    Old generation flag (0=young, 1=old)
-// Bit 2:    Remembered-set flag (0=not in rset, 1=in rset)
+// Bit 2:    Remembered-set flag (1=card already dirtied since the last collection)
 #define GC_MARK_BIT    0x1ULL
 #define GC_OLD_BIT     0x2ULL
 #define GC_RSET_BIT    0x4ULL
 
 // Young generation bump allocator sizing
 #define YOUNG_REGION_SIZE  (128 * 1024 * 1024)  // 128MB young region
-#define DIRTY_LIST_MAX     65536               // max dirty old-gen objects tracked
+#define YOUNG_STRESS_SIZE  (256 * 1024)         // nursery under 'gc-stress'
+
+// Thread-local allocation buffers (TLABs): each mutator carves TLAB_SIZE chunks
+// out of the nursery with one shared CAS, then bump-allocates inside its chunk with
+// no atomics. Objects of TLAB_DIRECT_MIN bytes or more skip the TLAB and take the
+// shared bump directly, so a large object never strands most of a chunk.
+#define TLAB_SIZE          (32 * 1024)
+#define TLAB_DIRECT_MIN    (TLAB_SIZE / 4)
+
+// Size word of a nursery gap left by a retired TLAB. The young walk in
+// CollectMemory parses the nursery block by block; a gap is skipped by its size
+// (low bits) rather than read as an object header.
+#define YOUNG_FILLER_BIT   (1ULL << 63)
+
+// Parallel marking: persistent GC worker threads (the collecting thread is worker
+// 0). Count comes from 'gc-threads' in config.prop, defaulting to the core count.
+// A worker publishes part of its private mark stack for stealing once it holds
+// MARK_PUBLISH_MIN entries and another worker is idle; root frames are handed out
+// in tasks of MARK_ROOT_CHUNK frames.
+#define GC_THREADS_MAX     16
+#define GC_THREADS_DEFAULT 8
+#define MARK_PUBLISH_MIN   64
+#define MARK_ROOT_CHUNK    64
+
+// Concurrent marking ('gc-concurrent' in config.prop, or OBJECK_GC_CONCURRENT): a
+// minor GC that leaves the old generation past CONCURRENT_START_PERCENT of the
+// heap threshold marks the roots before resuming the world, and a background
+// thread traces the old generation while mutators run. The next collection
+// finishes the cycle as a major GC (the remark), re-tracing from the roots and
+// from marked objects on dirty cards. The tracer polls for an abort every
+// CONCURRENT_POLL_ENTRIES mark entries.
+#define CONCURRENT_START_PERCENT 75
+#define CONCURRENT_POLL_ENTRIES  256
+
+// The JIT can bump the TLAB inline only where the buffer sits at a fixed offset
+// from the thread pointer (initial-exec TLS, addressed off %fs). Elsewhere the
+// inline path falls back to the shared nursery CAS.
+#if defined(_X64) && !defined(_WIN32) && !defined(_OSX) && defined(__GNUC__)
+#define _TLAB_JIT_INLINE
+#endif
 
 // used to monitor the state of active stack frames
 struct StackFrameMonitor {
@@ -81,6 +147,67 @@ struct StackFrameMonitor {
   size_t* stack_pos;
 };
 
+// A mutator's current nursery chunk. Field order is fixed: the AMD64 JIT addresses
+// top/end/allocated by offset for its inline NEW_OBJ_INST.
+struct ThreadAllocBuffer {
+  uint8_t* top;       // next free byte
+  uint8_t* end;       // end of the chunk
+  size_t allocated;   // instance bytes not yet added to allocation_size
+};
+
+// Header at the start of every old-generation page run. Bitmaps are indexed by
+// granule offset from the page start, so a cell's bits are found without dividing
+// by its size, and a sweep is a linear scan of (alloc & ~mark).
+struct OldPage {
+  size_t alloc_bits[OLD_BITMAP_WORDS];  // set at the first granule of each live cell
+  size_t mark_bits[OLD_BITMAP_WORDS];   // cleared at the end of every collection
+  size_t cell_size;                     // bytes per cell (a large page: its one block)
+  size_t run_size;                      // bytes mapped for this run
+  size_t live_count;                    // allocated cells
+  size_t* free_list;                    // swept cells, linked through word [0]
+  uint8_t* bump;                        // next never-used cell
+  OldPage* next_partial;                // next page of this size class with room
+  std::atomic<bool> has_marks;          // a mark bit was set since the last clear
+  bool large;
+  uint8_t cards[OLD_CARD_COUNT];        // non-zero: card holds a written-to object
+};
+
+// A gray object: marked, with fields still to trace
+struct MarkEntry {
+  size_t* mem;
+  StackDclr** dclrs;   // field layout, or nullptr for an object/int array
+  long dclrs_num;
+  bool typed;          // arrays: elements are known object references
+};
+
+// Per-worker mark state. 'local' is touched only by its owner; batches move to
+// 'shared' for other workers to steal, guarded by 'shared_lock'.
+struct GcWorker {
+  std::vector<MarkEntry> local;
+  std::vector<MarkEntry> shared;
+  std::atomic<size_t> shared_size;
+#ifdef _WIN32
+  CRITICAL_SECTION shared_lock;
+#else
+  pthread_mutex_t shared_lock;
+#endif
+};
+
+// A slice of the root set, claimed by one GC worker
+enum GcRootKind {
+  ROOT_STATIC = 0,    // class statics + mid-spawn thread roots
+  ROOT_STACK,         // the collecting thread's operand stack
+  ROOT_OP_STACK,      // another thread's operand stack (gc_op_stacks[start])
+  ROOT_PDA_FRAMES,    // interpreter frames gc_pda_frames[start, end)
+  ROOT_JIT_FRAMES     // JIT frames jit_frames[start, end)
+};
+
+struct GcRootTask {
+  GcRootKind kind;
+  size_t start;
+  size_t end;
+};
+
 // holders
 struct CollectionInfo {
   size_t* op_stack;
@@ -107,43 +234,93 @@ class MemoryManager {
   // marks-but-cannot-forward -> a bare GC mark bit written into a root -> AV.
   static std::unordered_set<size_t**> pending_thread_roots;
   static std::vector<StackFrame*> jit_frames; // deleted elsewhere
-  // Free-list cache: intrusive singly-linked lists bucketed by power-of-two pool
-  // size (bucket index = log2(pool)). Each cached block stores its actual size in
-  // word [0] (preserved across caching) and the next-free pointer in word [1]
-  // (cleared on reuse), so caching a freed block needs no separate node
-  // allocation. Pools run 2^0..2^22 (ALIGN_POOL_MAX), so 23 buckets cover them.
-  static const size_t FREE_POOL_COUNT = 23;
-  // Keep the bucket count locked to ALIGN_POOL_MAX: PoolIndex(ALIGN_POOL_MAX)
-  // must be the last valid index, else AddFreeCache/GetFreeMemory index out of
-  // bounds. Fails loudly if either constant is changed without the other.
-  static_assert((size_t(1) << (FREE_POOL_COUNT - 1)) == ALIGN_POOL_MAX,
-                "FREE_POOL_COUNT must equal log2(ALIGN_POOL_MAX) + 1");
-  // The intrusive list stores the next-free link in block word [1], so every
-  // cached block must be at least 2 words. GetMemory blocks are alloc_size + a
-  // size word, and alloc_size includes EXTRA_BUF_SIZE words, so this holds.
-  static_assert(EXTRA_BUF_SIZE >= 1,
-                "free-list link lives in block word [1]; blocks need >= 2 words");
-  static size_t* free_buckets[FREE_POOL_COUNT];
-  // Mutated only under 'free_memory_cache_lock', but read without it by the sweep
-  // (CollectMemory, under 'allocated_lock') to decide whether the cache is oversized.
-  // Atomic so that read is not a data race; relaxed everywhere, since the lock still
-  // orders the mutations and the sweep's use is a heuristic threshold that tolerates
-  // a value one cycle stale. Not taking the lock for that read also keeps it from
-  // having to be released again for the ClearFreeMemory call it guards.
-  static std::atomic<size_t> free_memory_cache_size;
+  static std::vector<StackFrame*> gc_pda_frames;
+  static std::vector<std::pair<size_t*, size_t> > gc_op_stacks;   // (op_stack, top index)
+
+  // Parallel mark workers. 'gc_workers[0]' belongs to whichever thread is
+  // collecting; the rest are persistent threads started on the first collection
+  // and parked on 'gc_start_cv' between collections. 'gc_worker' is the calling
+  // thread's entry while it marks.
+  static GcWorker* gc_workers;
+  static long gc_worker_count;
+  static thread_local GcWorker* gc_worker;
+  static std::atomic<long> gc_active_workers;
+  static std::vector<GcRootTask> gc_root_tasks;
+  static std::atomic<size_t> gc_root_next;
+  static CollectionInfo* gc_info;
+  static bool gc_workers_started;
+  static bool gc_workers_stop;
+  static long gc_mark_epoch;
+  static long gc_workers_done;
+#ifdef _WIN32
+  static CRITICAL_SECTION gc_pool_lock;
+  static CONDITION_VARIABLE gc_start_cv;
+  static CONDITION_VARIABLE gc_done_cv;
+  static std::vector<HANDLE> gc_threads;
+#else
+  static pthread_mutex_t gc_pool_lock;
+  static pthread_cond_t gc_start_cv;
+  static pthread_cond_t gc_done_cv;
+  static std::vector<pthread_t> gc_threads;
+#endif
 
+  // Concurrent marking (see CONCURRENT_START_PERCENT). 'concurrent_cycle' spans the
+  // initial mark to the remark; old-gen cells allocated meanwhile are born marked.
+  // 'concurrent_mark' is set while the tracer thread may run, which keeps marking
+  // off the nursery (young objects are traced at the remark). The tracer uses
+  // 'gc_workers[0]', so leftover work is drained by the remark's worker 0.
+  static bool gc_concurrent;
+  static std::atomic<bool> concurrent_cycle;
+  static std::atomic<bool> concurrent_mark;
+  static std::atomic<bool> concurrent_abort;
+  static std::atomic<bool> concurrent_done;
+  static bool concurrent_thread_live;
+  static size_t concurrent_start_size;    // allocation_size at the initial mark
+  static bool concurrent_remark;
+#ifdef _WIN32
+  static HANDLE concurrent_thread;
+#else
+  static pthread_t concurrent_thread;
+#endif
   // Young generation: contiguous bump-allocated region
   static uint8_t* young_region;
   static size_t young_region_size;
   static std::atomic<size_t> young_offset;
 
-  // Old generation: individually allocated, tracked in set
-  static std::unordered_set<size_t*> old_generation;
+  // Per-thread nursery chunks. 'tlab_buffers' lists every thread's buffer so a
+  // collection can retire them all (see RetireAllocBuffers); it is guarded by
+  // 'tlab_lock'. The buffer itself is only touched by its owning thread, or by the
+  // collector while that thread is parked.
+#ifdef _TLAB_JIT_INLINE
+  static thread_local ThreadAllocBuffer tlab __attribute__((tls_model("initial-exec")));
+#else
+  static thread_local ThreadAllocBuffer tlab;
+#endif
+  static std::unordered_set<ThreadAllocBuffer*> tlab_buffers;
+
+  // Old generation: segregated-fit pages (see OldPage). 'old_pages' lists every
+  // page in use, 'old_partial' heads each size class's list of pages with a free
+  // cell and 'old_empty' keeps swept-empty pages for reuse by any class. All of it
+  // is guarded by 'allocated_lock'.
+  static OldPage** old_page_map[(size_t)1 << OLD_MAP_ROOT_BITS];
+  static std::vector<OldPage*> old_pages;
+  static std::vector<OldPage*> old_empty;
+  static OldPage* old_partial[OLD_CLASS_MAX];
+  static size_t old_class_size[OLD_CLASS_MAX];
+  static size_t old_class_count;
+  static uint8_t old_class_index[OLD_SMALL_MAX / OLD_GRANULE + 1];
+  static size_t old_object_count;
   static size_t old_allocation_size;
 
-  // Lock-free dirty list (replaces remembered_set + remembered_set_lock)
-  static size_t* dirty_list[DIRTY_LIST_MAX];
-  static std::atomic<size_t> dirty_count;
+  // Objects recorded by the write barrier since the last collection (statistics;
+  // the remembered set itself is the per-page card table)
+  static std::atomic<size_t> remembered_count;
+
+  // 'gc-verify' / 'gc-stress' in config.prop: check the card table against every
+  // old->young edge before each minor GC and that no old object still points into
+  // the nursery after it. 'gc-stress' also shrinks the nursery to
+  // YOUNG_STRESS_SIZE so minor collections run constantly.
+  static bool gc_verify;
 
   static std::atomic<bool> minor_gc_mode;
 
@@ -171,7 +348,6 @@ class MemoryManager {
   static CRITICAL_SECTION pending_thread_root_lock;
   static CRITICAL_SECTION allocated_lock;
   static CRITICAL_SECTION marked_sweep_lock;
-  static CRITICAL_SECTION free_memory_cache_lock;
 #else
   static pthread_mutex_t pda_monitor_lock;
   static pthread_mutex_t pda_frame_lock;
@@ -179,7 +355,11 @@ class MemoryManager {
   static pthread_mutex_t pending_thread_root_lock;
   static pthread_mutex_t allocated_lock;
   static pthread_mutex_t marked_sweep_lock;
-  static pthread_mutex_t free_memory_cache_lock;
+#endif
+#ifdef _WIN32
+  static CRITICAL_SECTION tlab_lock;
+#else
+  static pthread_mutex_t tlab_lock;
 #endif
     
   // allocation_size is bumped lock-free on the young fast path (AllocateObject and
@@ -206,8 +386,19 @@ class MemoryManager {
   static std::atomic<size_t> gc_alloc_at_last;
   static std::atomic<long> gc_contention;
 
+  // Concurrent marking metrics: cycles finished by a remark, cycles whose tracer
+  // had not emptied its mark stack by then, and phase timings (us).
+  static std::atomic<long> gc_concurrent_cycles;
+  static std::atomic<long> gc_concurrent_incomplete;
+  static std::atomic<long> gc_concurrent_mark_last_us;
+  static std::atomic<long> gc_initial_mark_last_us;
+  static std::atomic<long> gc_initial_mark_max_us;
+  static std::atomic<long> gc_remark_last_us;
+  static std::atomic<long> gc_remark_max_us;
+
   // if return true, trace memory otherwise do not
   static inline bool MarkMemory(size_t* mem);
+  static inline bool MarkOldMemory(size_t* mem);
 
   // Generational GC helpers
   static inline bool IsYoung(size_t* mem) {
@@ -219,7 +410,33 @@ class MemoryManager {
   }
 
   static inline bool IsAllocated(size_t* mem) {
-    return IsYoung(mem) || old_generation.count(mem);
+    return IsYoung(mem) || IsOldAllocated(mem);
+  }
+
+  // Page owning 'addr' if it falls in the old generation, else nullptr
+  static inline OldPage* LookupOldPage(uintptr_t addr) {
+    const uintptr_t index = addr >> OLD_PAGE_SHIFT;
+    if(index >> (OLD_MAP_ROOT_BITS + OLD_MAP_LEAF_BITS)) {
+      return nullptr;
+    }
+    OldPage** leaf = old_page_map[index >> OLD_MAP_LEAF_BITS];
+    return leaf ? leaf[index & (((uintptr_t)1 << OLD_MAP_LEAF_BITS) - 1)] : nullptr;
+  }
+
+  // True if 'mem' is the start of a live old-gen object: its block must sit on a
+  // granule boundary within the first page of a run, with that granule's
+  // allocated bit set.
+  static inline bool IsOldAllocated(size_t* mem) {
+    const uintptr_t raw = (uintptr_t)mem - sizeof(size_t) * (EXTRA_BUF_SIZE + 1);
+    if(raw & (OLD_GRANULE - 1)) {
+      return false;
+    }
+    OldPage* page = LookupOldPage(raw);
+    if(!page || raw - (uintptr_t)page >= OLD_PAGE_SIZE) {
+      return false;
+    }
+    const size_t bit = (raw - (uintptr_t)page) >> OLD_GRANULE_SHIFT;
+    return (page->alloc_bits[bit >> 6] >> (bit & 63)) & 1;
   }
 
   static inline bool IsOldGen(size_t* mem) {
@@ -230,7 +447,7 @@ class MemoryManager {
   // address if the slot points to a promoted young object, else 0. Conservative scans
   // (operand stacks, JIT temps) pass untyped words here: a non-pointer value that
   // merely aliases the young address range is rejected because its forwarding word
-  // won't be a genuine member of old_generation. (Do NOT gate on IsAllocated/IsOldGen:
+  // won't be a genuine old-gen allocation. (Do NOT gate on IsAllocated/IsOldGen:
   // IsAllocated==IsYoung for young-range values and would also misfire on real old-gen
   // pointers whose MARKED_FLAG holds GC_OLD_BIT, not a forwarding address.)
   static inline size_t ForwardedAddr(size_t* ref) {
@@ -247,7 +464,7 @@ class MemoryManager {
        p >= young_region + sizeof(size_t) &&
        p < young_region + young_offset.load(std::memory_order_acquire)) {
       const size_t fwd = ref[MARKED_FLAG];
-      if(fwd && old_generation.count((size_t*)fwd)) {
+      if(fwd && IsOldAllocated((size_t*)fwd)) {
         return fwd;
       }
     }
@@ -263,8 +480,28 @@ class MemoryManager {
     }
   }
 
+  // TLAB bump allocation of 'aligned_total' nursery bytes; nullptr when the
+  // nursery is exhausted. Refill takes a fresh chunk (or, for large objects, a
+  // direct shared bump) once the current chunk cannot fit the request.
+  static inline uint8_t* AllocateYoung(const size_t aligned_total) {
+    ThreadAllocBuffer& buf = tlab;
+    if((size_t)(buf.end - buf.top) >= aligned_total) {
+      uint8_t* raw_mem = buf.top;
+      buf.top += aligned_total;
+      return raw_mem;
+    }
+    return RefillAllocBuffer(aligned_total);
+  }
+  static uint8_t* RefillAllocBuffer(const size_t aligned_total);
+  static uint8_t* AllocateYoungShared(const size_t aligned_total);
+  static void RetireAllocBuffer(ThreadAllocBuffer* buf);
+  static void RetireAllocBuffers();
+  static void FillYoungGap(uint8_t* start, uint8_t* end);
+  friend struct AllocBufferRegistration;
+
   static void CollectMinor(size_t* op_stack, size_t stack_pos);
   static void CollectMajor(size_t* op_stack, size_t stack_pos);
+  static void CollectForOldAllocation(size_t size, size_t* op_stack, size_t stack_pos);
   static void ScanDirtyObject(size_t* mem);
   static void FixupObject(size_t* mem);
   static void FixupMemory(size_t* mem, StackDclr** dclrs, const long dcls_size);
@@ -275,26 +512,58 @@ class MemoryManager {
   static long mem_cycle;
 #endif
   
+  // mark memory: root scans, run as tasks by the GC workers
+  static void CheckStatic();
+  static void CheckStack(size_t* op_stack, size_t stack_pos);
+  static void GatherPdaRoots();
+  static void CheckPdaFrame(StackFrame* frame);
+  static void CheckJitFrame(StackFrame* frame);
+
+  // parallel marking (see GcWorker)
+  static void StartGcWorkers();
+  static void StopGcWorkers();
+  static void MarkParallel(CollectionInfo* info);
+  static void GatherRootTasks(CollectionInfo* info);
+  static void ReleaseRootTasks();
+  static void RunMarkWorker(GcWorker* worker);
+  static void ScanRootTask(const GcRootTask& task);
+  static void TraceMarkEntry(const MarkEntry& entry);
+  static void DrainMarkStack(GcWorker* worker);
+  static bool StealMarkWork(GcWorker* thief);
+  static bool HasSharedMarkWork();
+  static void PublishMarkWork(GcWorker* worker);
+  static inline void PushMark(size_t* mem, StackDclr** dclrs, long dclrs_num, bool typed) {
+    GcWorker* worker = gc_worker;
+    worker->local.push_back({ mem, dclrs, dclrs_num, typed });
+    if(worker->local.size() >= MARK_PUBLISH_MIN &&
+       gc_active_workers.load(std::memory_order_relaxed) < gc_worker_count &&
+       !worker->shared_size.load(std::memory_order_relaxed)) {
+      PublishMarkWork(worker);
+    }
+  }
 #ifdef _WIN32
-  // mark memory
-  static unsigned int WINAPI CheckStatic(LPVOID arg);
-  static unsigned int WINAPI CheckStack(LPVOID arg);
-  static unsigned int WINAPI CheckPdaRoots(LPVOID arg);
-  static unsigned int WINAPI CheckJitRoots(LPVOID arg);
-  
-  // recover memory
-  static void CollectAllMemory(size_t* op_stack, size_t stack_pos);
-  static unsigned int WINAPI CollectMemory(LPVOID arg);
-#else  
-  // mark memory
-  static void* CheckStatic(void* arg);
-  static void* CheckStack(void* arg);
-  static void* CheckPdaRoots(void* arg);
-  static void* CheckJitRoots(void* arg);
+  static unsigned int WINAPI GcWorkerMain(LPVOID arg);
+#else
+  static void* GcWorkerMain(void* arg);
+#endif
+
+  // concurrent marking (see concurrent_cycle)
+  static void StartConcurrentMark(CollectionInfo* info);
+  static void FinishConcurrentMark();
+  static void StopConcurrentMark();
+  static void RescanMarkedObject(size_t* mem);
+  static inline bool IsConcurrentSkip(size_t* mem) {
+    return concurrent_mark.load(std::memory_order_acquire) && IsYoung(mem);
+  }
+#ifdef _WIN32
+  static unsigned int WINAPI ConcurrentMarkMain(LPVOID arg);
+#else
+  static void* ConcurrentMarkMain(void* arg);
+#endif
+
   // recover memory
   static void CollectAllMemory(size_t* op_stack, size_t stack_pos);
-  static void* CollectMemory(void* arg);
-#endif
+  static void CollectMemory(CollectionInfo* info);
     
   static inline StackClass* GetClassMapping(size_t* mem) {
     if(!mem) {
@@ -318,22 +587,33 @@ class MemoryManager {
     return nullptr;
   }
 
-  static size_t* GetMemory(size_t alloc_size);
-  static void AddFreeMemory(size_t* raw_mem);
-  void static inline AddFreeCache(size_t pool, size_t* raw_mem);
-  static size_t* GetFreeMemory(size_t size);
-  static size_t AlignMemorySize(size_t size);
-  static void ClearFreeMemory();
-
-  // Bucket index for a power-of-two pool size (log2). 'pool' is always a power
-  // of two produced by AlignMemorySize, so the lowest set bit is its log2.
-  static inline size_t PoolIndex(size_t pool) {
+  // Old generation allocation and sweeping. Callers hold 'allocated_lock'.
+  static size_t* AllocateOld(size_t alloc_size);
+  static OldPage* NewOldPage(size_t cell_size, size_t run_size);
+  static void MapOldPage(OldPage* page, OldPage* owner);
+  static void FreeOldPage(OldPage* page);
+  static size_t SweepOldSpace();
+  static void ClearOldMarks();
+  static void ReleaseEmptyOldPages();
+  static void ReleaseOldSpace();
+  template<typename F> static void ForEachOldObject(F fn);
+  template<typename F> static void ForEachDirtyCardObject(F fn);
+  static void ClearCards();
+
+  // gc-verify checks (see gc_verify)
+  static void VerifyCardTable();
+  static void VerifyNoYoungRefs();
+  static void VerifyMarkClosure();
+  static void VerifyFailed(size_t* holder, size_t* ref, const wchar_t* what);
+
+  // Index of the lowest set bit of a non-zero bitmap word
+  static inline size_t LowestBit(size_t bits) {
 #ifdef _WIN32
     unsigned long idx;
-    _BitScanForward64(&idx, (unsigned __int64)pool);
+    _BitScanForward64(&idx, (unsigned __int64)bits);
     return (size_t)idx;
 #else
-    return (size_t)__builtin_ctzll(pool);
+    return (size_t)__builtin_ctzll(bits);
 #endif
   }
   
@@ -353,6 +633,12 @@ class MemoryManager {
   static void* YoungRegionAddr() { return (void*)&young_region; }
   static void* YoungRegionSizeAddr() { return (void*)&young_region_size; }
   static void* AllocationSizeAddr() { return (void*)&allocation_size; }
+#ifdef _TLAB_JIT_INLINE
+  // Offset of the calling thread's ThreadAllocBuffer from the thread pointer (%fs
+  // base). Initial-exec TLS makes this the same for every thread, so the JIT can
+  // bake it into NEW_OBJ_INST as a %fs-relative operand.
+  static long AllocBufferTlsOffset();
+#endif
   // Bracket a blocking operation (sleep / join / I/O): the thread's VM state is
   // frozen and scannable, so count it as parked for the duration.
   static void BeginBlocking();
@@ -374,7 +660,7 @@ class MemoryManager {
   static bool   IsStwActive()          { return stw_active.load(std::memory_order_acquire); }
   static size_t GetNurseryUsed()       { return young_offset.load(std::memory_order_relaxed); }
   static size_t GetNurseryCapacity()   { return young_region_size; }
-  static size_t GetRememberedCount()   { return dirty_count.load(std::memory_order_relaxed); }
+  static size_t GetRememberedCount()   { return remembered_count.load(std::memory_order_relaxed); }
 
   // Phase 3 NICE metric getters (lock-free reads).
   static long   GetPauseLastUs()       { return gc_pause_last_us.load(std::memory_order_relaxed); }
@@ -392,6 +678,14 @@ class MemoryManager {
     return now > at ? now - at : 0;
   }
   static long   GetGcContention()      { return gc_contention.load(std::memory_order_relaxed); }
+  static long   GetConcurrentCycles()     { return gc_concurrent_cycles.load(std::memory_order_relaxed); }
+  static long   GetConcurrentIncomplete() { return gc_concurrent_incomplete.load(std::memory_order_relaxed); }
+  static long   GetConcurrentMarkLastUs() { return gc_concurrent_mark_last_us.load(std::memory_order_relaxed); }
+  static long   GetInitialMarkLastUs()    { return gc_initial_mark_last_us.load(std::memory_order_relaxed); }
+  static long   GetInitialMarkMaxUs()     { return gc_initial_mark_max_us.load(std::memory_order_relaxed); }
+  static long   GetRemarkLastUs()         { return gc_remark_last_us.load(std::memory_order_relaxed); }
+  static long   GetRemarkMaxUs()          { return gc_remark_max_us.load(std::memory_order_relaxed); }
+  static bool   IsConcurrentMarking()     { return concurrent_cycle.load(std::memory_order_relaxed); }
   static size_t GetOldGenBytes()       { return old_allocation_size; }  // single-word benign read
   static long   GetUptimeMs();         // defined in memory.cpp (steady_clock)
 
@@ -410,15 +704,22 @@ class MemoryManager {
     mem_logger.close();
 #endif
 
-    ClearFreeMemory();
+    // Stop a concurrent trace before its pages go away
+    StopConcurrentMark();
+
+    // Unmap old generation pages
+    ReleaseOldSpace();
 
-    // Free old generation (individually allocated)
-    for(auto iter = old_generation.begin(); iter != old_generation.end(); ++iter) {
-      size_t* mem = *iter;
-      mem -= EXTRA_BUF_SIZE + 1;
-      free(mem);
+    // Join the mark workers
+    StopGcWorkers();
+#ifdef _WIN32
+    for(long i = 0; i < gc_worker_count; ++i) {
+      DeleteCriticalSection(&gc_workers[i].shared_lock);
     }
-    old_generation.clear();
+#endif
+    delete[] gc_workers;
+    gc_workers = nullptr;
+    gc_worker_count = 0;
 
     // Free young region (single contiguous block)
     if(young_region) {
@@ -430,7 +731,14 @@ class MemoryManager {
       young_region = nullptr;
     }
     young_offset.store(0, std::memory_order_relaxed);
-    dirty_count.store(0, std::memory_order_relaxed);
+    remembered_count.store(0, std::memory_order_relaxed);
+
+    // Registered TLABs point into the region just released; drop their chunks
+    for(auto iter = tlab_buffers.begin(); iter != tlab_buffers.end(); ++iter) {
+      ThreadAllocBuffer* buf = *iter;
+      buf->top = buf->end = nullptr;
+      buf->allocated = 0;
+    }
 
 #ifdef _WIN32
     DeleteCriticalSection(&jit_frame_lock);
@@ -438,7 +746,8 @@ class MemoryManager {
     DeleteCriticalSection(&pending_thread_root_lock);
     DeleteCriticalSection(&allocated_lock);
     DeleteCriticalSection(&marked_sweep_lock);
-    DeleteCriticalSection(&free_memory_cache_lock);
+    DeleteCriticalSection(&tlab_lock);
+    DeleteCriticalSection(&gc_pool_lock);
 #endif
 
     initialized = false;
@@ -471,10 +780,12 @@ class MemoryManager {
   static size_t* AllocateObject(const long obj_id, size_t* op_stack, size_t stack_pos, bool collect = true);
   static size_t* AllocateArray(const size_t size, const MemoryType type, size_t* op_stack, size_t stack_pos, bool collect = true);
 
-  // Generational GC write barrier: lock-free dirty list append. Mutator
-  // threads can race each other here (the collector only touches these bits
-  // under stop-the-world), so the flag word is accessed atomically — a plain
-  // |= is a data race that weakly-ordered hardware (ARM64) is free to break.
+  // Generational GC write barrier: dirties the card holding an old object's
+  // header. GC_RSET_BIT filters repeat stores to the same object until the next
+  // collection. Mutator threads can race each other here (the collector only
+  // touches these bits under stop-the-world), so the flag word is accessed
+  // atomically — a plain |= is a data race that weakly-ordered hardware (ARM64)
+  // is free to break. The card byte is only ever set to 1, so racing stores agree.
   static inline void WriteBarrier(size_t* target_obj) {
     if(!target_obj) return;
 #ifdef _WIN32
@@ -489,16 +800,15 @@ class MemoryManager {
 #else
     __atomic_fetch_or(&target_obj[MARKED_FLAG], GC_RSET_BIT, __ATOMIC_RELAXED);
 #endif
-    size_t idx = dirty_count.fetch_add(1, std::memory_order_relaxed);
-    if(idx < DIRTY_LIST_MAX) {
-      dirty_list[idx] = target_obj;
-    }
-    // If overflow: next minor GC falls back to full old-gen scan
+    const uintptr_t raw = (uintptr_t)target_obj - sizeof(size_t) * (EXTRA_BUF_SIZE + 1);
+    OldPage* page = (OldPage*)(raw & ~(OLD_PAGE_SIZE - 1));
+    page->cards[(raw - (uintptr_t)page) >> OLD_CARD_SHIFT] = 1;
+    remembered_count.fetch_add(1, std::memory_order_relaxed);
   }
 
   // Non-inline, stably-addressable entry point for JIT-emitted write barriers. The
   // JIT inlines the fast-path test (skip when the holder is young or already tracked)
-  // and only calls this for the rare slow path that records the holder in the rset.
+  // and only calls this for the rare slow path that dirties the holder's card.
   static void JitWriteBarrier(size_t* target_obj);
   
   // object verification
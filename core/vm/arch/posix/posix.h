@@ -51,6 +51,11 @@
 #include <sys/un.h>
 #include <pwd.h>
 #include <grp.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
 
 #define SOCKET int
 
@@ -458,12 +463,21 @@ public:
     return client;
   }
   
+  // a peer that hung up reports an error instead of raising SIGPIPE
   static int WriteByte(const char value, SOCKET sock) {
+#ifdef MSG_NOSIGNAL
+    return static_cast<int>(send(sock, &value, 1, MSG_NOSIGNAL));
+#else
     return static_cast<int>(send(sock, &value, 1, 0));
+#endif
   }
   
   static int WriteBytes(const char* values, int len, SOCKET sock) {
+#ifdef MSG_NOSIGNAL
+    return static_cast<int>(send(sock, values, len, MSG_NOSIGNAL));
+#else
     return static_cast<int>(send(sock, values, len, 0));
+#endif
   }
   
   static char ReadByte(SOCKET sock, int &status) {
@@ -495,6 +509,39 @@ public:
     close(sock);
   }
 
+  static bool SetNonBlocking(SOCKET sock, bool enable) {
+    const int flags = fcntl(sock, F_GETFL, 0);
+    if(flags < 0) {
+      return false;
+    }
+
+    return fcntl(sock, F_SETFL, enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) == 0;
+  }
+
+  // Non-blocking I/O for event loops. Returns the byte count, 0 when the peer
+  // closed (reads only), -1 when the call would block and -2 on error.
+  static int ReadNonBlocking(char* values, int len, SOCKET sock) {
+    const int status = static_cast<int>(recv(sock, values, len, MSG_DONTWAIT));
+    if(status < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? -1 : -2;
+    }
+
+    return status;
+  }
+
+  static int WriteNonBlocking(const char* values, int len, SOCKET sock) {
+#ifdef MSG_NOSIGNAL
+    const int status = static_cast<int>(send(sock, values, len, MSG_DONTWAIT | MSG_NOSIGNAL));
+#else
+    const int status = static_cast<int>(send(sock, values, len, MSG_DONTWAIT));
+#endif
+    if(status < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? -1 : -2;
+    }
+
+    return status;
+  }
+
   static bool SetKeepAlive(SOCKET sock, bool enable) {
     int val = enable ? 1 : 0;
     return setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, &val, sizeof(val)) == 0;
@@ -627,6 +674,188 @@ public:
   }
 };
 
+/****************************
+ * Socket readiness poller, epoll
+ * on Linux and poll() elsewhere
+ ****************************/
+#define POLL_EVENT_READ 1
+#define POLL_EVENT_WRITE 2
+#define POLL_EVENT_HANGUP 4
+
+#define POLL_CTL_ADD 0
+#define POLL_CTL_MOD 1
+#define POLL_CTL_DEL 2
+
+class SocketPoller {
+#ifdef __linux__
+  int epoll_fd;
+
+  static uint32_t ToNative(int events) {
+    uint32_t native = 0;
+    if(events & POLL_EVENT_READ) {
+      native |= EPOLLIN | EPOLLRDHUP;
+    }
+    if(events & POLL_EVENT_WRITE) {
+      native |= EPOLLOUT;
+    }
+    return native;
+  }
+#else
+  // Control() and Wait() must be called from the same thread
+  std::vector<struct pollfd> poll_fds;
+
+  static short ToNative(int events) {
+    short native = 0;
+    if(events & POLL_EVENT_READ) {
+      native |= POLLIN;
+    }
+    if(events & POLL_EVENT_WRITE) {
+      native |= POLLOUT;
+    }
+    return native;
+  }
+#endif
+
+  SocketPoller() {
+#ifdef __linux__
+    epoll_fd = -1;
+#endif
+  }
+
+ public:
+  ~SocketPoller() {
+#ifdef __linux__
+    if(epoll_fd > -1) {
+      close(epoll_fd);
+    }
+#endif
+  }
+
+  static SocketPoller* Create() {
+    SocketPoller* poller = new SocketPoller;
+#ifdef __linux__
+    poller->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(poller->epoll_fd < 0) {
+      delete poller;
+      return nullptr;
+    }
+#endif
+    return poller;
+  }
+
+  bool Control(int op, SOCKET sock, int events) {
+#ifdef __linux__
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = ToNative(events);
+    event.data.fd = sock;
+
+    switch(op) {
+    case POLL_CTL_ADD:
+      return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock, &event) == 0;
+
+    case POLL_CTL_MOD:
+      return epoll_ctl(epoll_fd, EPOLL_CTL_MOD, sock, &event) == 0;
+
+    case POLL_CTL_DEL:
+      return epoll_ctl(epoll_fd, EPOLL_CTL_DEL, sock, &event) == 0;
+    }
+
+    return false;
+#else
+    for(size_t i = 0; i < poll_fds.size(); ++i) {
+      if(poll_fds[i].fd == sock) {
+        if(op == POLL_CTL_ADD) {
+          return false;
+        }
+        else if(op == POLL_CTL_MOD) {
+          poll_fds[i].events = ToNative(events);
+        }
+        else {
+          poll_fds[i] = poll_fds.back();
+          poll_fds.pop_back();
+        }
+        return true;
+      }
+    }
+
+    if(op != POLL_CTL_ADD) {
+      return false;
+    }
+
+    struct pollfd poll_fd;
+    poll_fd.fd = sock;
+    poll_fd.events = ToNative(events);
+    poll_fd.revents = 0;
+    poll_fds.push_back(poll_fd);
+
+    return true;
+#endif
+  }
+
+  // Waits up to timeout_ms (-1 for no limit) and fills at most max ready
+  // sockets and their POLL_EVENT_* masks. Returns the ready count, 0 on
+  // timeout or interrupt and -1 on error.
+  int Wait(SOCKET* socks, int* events, int max, int timeout_ms) {
+    if(max <= 0) {
+      return 0;
+    }
+
+#ifdef __linux__
+    const int batch = max < 256 ? max : 256;
+    struct epoll_event ready[256];
+    const int count = epoll_wait(epoll_fd, ready, batch, timeout_ms);
+    if(count < 0) {
+      return errno == EINTR ? 0 : -1;
+    }
+
+    for(int i = 0; i < count; ++i) {
+      int mask = 0;
+      if(ready[i].events & EPOLLIN) {
+        mask |= POLL_EVENT_READ;
+      }
+      if(ready[i].events & EPOLLOUT) {
+        mask |= POLL_EVENT_WRITE;
+      }
+      if(ready[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) {
+        mask |= POLL_EVENT_HANGUP;
+      }
+      socks[i] = ready[i].data.fd;
+      events[i] = mask;
+    }
+
+    return count;
+#else
+    const int count = poll(poll_fds.data(), (nfds_t)poll_fds.size(), timeout_ms);
+    if(count < 0) {
+      return errno == EINTR ? 0 : -1;
+    }
+
+    int found = 0;
+    for(size_t i = 0; i < poll_fds.size() && found < count && found < max; ++i) {
+      const short revents = poll_fds[i].revents;
+      if(revents) {
+        int mask = 0;
+        if(revents & POLLIN) {
+          mask |= POLL_EVENT_READ;
+        }
+        if(revents & POLLOUT) {
+          mask |= POLL_EVENT_WRITE;
+        }
+        if(revents & (POLLHUP | POLLERR | POLLNVAL)) {
+          mask |= POLL_EVENT_HANGUP;
+        }
+        socks[found] = poll_fds[i].fd;
+        events[found] = mask;
+        found++;
+      }
+    }
+
+    return found;
+#endif
+  }
+};
+
 /****************************
  * UDP socket support class
  ****************************/
@@ -469,6 +469,32 @@ class IPSocket {
     closesocket(sock);
   }
 
+  static bool SetNonBlocking(SOCKET sock, bool enable) {
+    u_long mode = enable ? 1 : 0;
+    return ioctlsocket(sock, FIONBIO, &mode) == 0;
+  }
+
+  // Non-blocking I/O for event loops, the socket must have been put in
+  // non-blocking mode. Returns the byte count, 0 when the peer closed (reads
+  // only), -1 when the call would block and -2 on error.
+  static int ReadNonBlocking(char* values, int len, SOCKET sock) {
+    const int status = recv(sock, values, len, 0);
+    if(status == SOCKET_ERROR) {
+      return WSAGetLastError() == WSAEWOULDBLOCK ? -1 : -2;
+    }
+
+    return status;
+  }
+
+  static int WriteNonBlocking(const char* values, int len, SOCKET sock) {
+    const int status = send(sock, values, len, 0);
+    if(status == SOCKET_ERROR) {
+      return WSAGetLastError() == WSAEWOULDBLOCK ? -1 : -2;
+    }
+
+    return status;
+  }
+
   static bool SetKeepAlive(SOCKET sock, bool enable) {
     BOOL val = enable ? TRUE : FALSE;
     return setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, (const char*)&val, sizeof(val)) == 0;
@@ -540,6 +566,116 @@ class IPSocket {
   static SOCKET Accept(SOCKET server, char* client_address, int& client_port);
 };
 
+/****************************
+ * Socket readiness poller
+ * (WSAPoll)
+ ****************************/
+#define POLL_EVENT_READ 1
+#define POLL_EVENT_WRITE 2
+#define POLL_EVENT_HANGUP 4
+
+#define POLL_CTL_ADD 0
+#define POLL_CTL_MOD 1
+#define POLL_CTL_DEL 2
+
+class SocketPoller {
+  // Control() and Wait() must be called from the same thread
+  std::vector<WSAPOLLFD> poll_fds;
+
+  static SHORT ToNative(int events) {
+    SHORT native = 0;
+    if(events & POLL_EVENT_READ) {
+      native |= POLLRDNORM;
+    }
+    if(events & POLL_EVENT_WRITE) {
+      native |= POLLWRNORM;
+    }
+    return native;
+  }
+
+  SocketPoller() {
+  }
+
+ public:
+  ~SocketPoller() {
+  }
+
+  static SocketPoller* Create() {
+    return new SocketPoller;
+  }
+
+  bool Control(int op, SOCKET sock, int events) {
+    for(size_t i = 0; i < poll_fds.size(); ++i) {
+      if(poll_fds[i].fd == sock) {
+        if(op == POLL_CTL_ADD) {
+          return false;
+        }
+        else if(op == POLL_CTL_MOD) {
+          poll_fds[i].events = ToNative(events);
+        }
+        else {
+          poll_fds[i] = poll_fds.back();
+          poll_fds.pop_back();
+        }
+        return true;
+      }
+    }
+
+    if(op != POLL_CTL_ADD) {
+      return false;
+    }
+
+    WSAPOLLFD poll_fd;
+    poll_fd.fd = sock;
+    poll_fd.events = ToNative(events);
+    poll_fd.revents = 0;
+    poll_fds.push_back(poll_fd);
+
+    return true;
+  }
+
+  // Waits up to timeout_ms (-1 for no limit) and fills at most max ready
+  // sockets and their POLL_EVENT_* masks. Returns the ready count, 0 on
+  // timeout and -1 on error.
+  int Wait(SOCKET* socks, int* events, int max, int timeout_ms) {
+    if(max <= 0) {
+      return 0;
+    }
+
+    if(poll_fds.empty()) {
+      Sleep(timeout_ms < 0 ? INFINITE : timeout_ms);
+      return 0;
+    }
+
+    const int count = WSAPoll(poll_fds.data(), (ULONG)poll_fds.size(), timeout_ms);
+    if(count == SOCKET_ERROR) {
+      return -1;
+    }
+
+    int found = 0;
+    for(size_t i = 0; i < poll_fds.size() && found < count && found < max; ++i) {
+      const SHORT revents = poll_fds[i].revents;
+      if(revents) {
+        int mask = 0;
+        if(revents & POLLRDNORM) {
+          mask |= POLL_EVENT_READ;
+        }
+        if(revents & POLLWRNORM) {
+          mask |= POLL_EVENT_WRITE;
+        }
+        if(revents & (POLLHUP | POLLERR | POLLNVAL)) {
+          mask |= POLL_EVENT_HANGUP;
+        }
+        socks[found] = poll_fds[i].fd;
+        events[found] = mask;
+        found++;
+      }
+    }
+
+    return found;
+  }
+};
+
 /****************************
  * UDP socket support class
  ****************************/
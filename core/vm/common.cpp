@@ -120,6 +120,9 @@ static bool h3_valid_header_name(const std::string& n)
 #include "arch/memory.h"
 #include "arch/posix/posix.h"
 #endif
+#ifndef _NO_JIT
+#include "arch/jit/jit_common.h"
+#endif
 
 // Process/system stats for Runtime->GetProperty("runtime.*") diagnostics
 #include <thread>
@@ -2364,6 +2367,30 @@ bool TrapProcessor::ProcessTrap(StackProgram* program, size_t* inst,
   case SOCK_TCP_SET_SNDBUF:
     return SockTcpSetSndBuf(program, inst, op_stack, stack_pos, frame);
 
+  case SOCK_TCP_SET_NONBLOCK:
+    return SockTcpSetNonBlock(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_TCP_ACCEPT_NB:
+    return SockTcpAcceptNb(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_TCP_READ_NB:
+    return SockTcpReadNb(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_TCP_WRITE_NB:
+    return SockTcpWriteNb(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_POLL_CREATE:
+    return SockPollCreate(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_POLL_CTL:
+    return SockPollCtl(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_POLL_WAIT:
+    return SockPollWait(program, inst, op_stack, stack_pos, frame);
+
+  case SOCK_POLL_CLOSE:
+    return SockPollClose(program, inst, op_stack, stack_pos, frame);
+
   case SOCK_TCP_SSL_CONNECT:
     return SockTcpSslConnect(program, inst, op_stack, stack_pos, frame);
 
@@ -4181,6 +4208,14 @@ static bool GetRuntimeStat(const std::wstring& key, std::wstring& out)
     { L"runtime.gc.promoted.total",[]() -> size_t { return MemoryManager::GetPromotedTotal(); } },
     { L"runtime.gc.old.bytes",     []() -> size_t { return MemoryManager::GetOldGenBytes(); } },
     { L"runtime.gc.contention",    []() -> size_t { return (size_t)MemoryManager::GetGcContention(); } },
+    { L"runtime.gc.concurrent.active",     []() -> size_t { return MemoryManager::IsConcurrentMarking() ? 1 : 0; } },
+    { L"runtime.gc.concurrent.cycles",     []() -> size_t { return (size_t)MemoryManager::GetConcurrentCycles(); } },
+    { L"runtime.gc.concurrent.incomplete", []() -> size_t { return (size_t)MemoryManager::GetConcurrentIncomplete(); } },
+    { L"runtime.gc.concurrent.mark_us",    []() -> size_t { return (size_t)MemoryManager::GetConcurrentMarkLastUs(); } },
+    { L"runtime.gc.initial_mark.last_us",  []() -> size_t { return (size_t)MemoryManager::GetInitialMarkLastUs(); } },
+    { L"runtime.gc.initial_mark.max_us",   []() -> size_t { return (size_t)MemoryManager::GetInitialMarkMaxUs(); } },
+    { L"runtime.gc.remark.last_us",        []() -> size_t { return (size_t)MemoryManager::GetRemarkLastUs(); } },
+    { L"runtime.gc.remark.max_us",         []() -> size_t { return (size_t)MemoryManager::GetRemarkMaxUs(); } },
     // Compiled-in protocol support. Http3Connect is compiled unconditionally --
     // its #else branch just fails -- so "the trap exists" proves nothing about
     // whether HTTP/3 is actually built. These are the only reliable way for a
@@ -4199,6 +4234,19 @@ static bool GetRuntimeStat(const std::wstring& key, std::wstring& out)
                                                     return 0;
 #endif
                                                   } },
+#ifndef _NO_JIT
+    { L"runtime.jit.compiled",             []() -> size_t { return (size_t)JitCompiler::GetCompiledCount(); } },
+    { L"runtime.jit.failed",               []() -> size_t { return (size_t)JitCompiler::GetFailedCount(); } },
+    { L"runtime.jit.queue.depth",          []() -> size_t { return (size_t)JitCompiler::GetQueueDepth(); } },
+    { L"runtime.jit.queue.max",            []() -> size_t { return (size_t)JitCompiler::GetQueueMax(); } },
+    { L"runtime.jit.compile.last_us",      []() -> size_t { return (size_t)JitCompiler::GetCompileLastUs(); } },
+    { L"runtime.jit.compile.max_us",       []() -> size_t { return (size_t)JitCompiler::GetCompileMaxUs(); } },
+    { L"runtime.jit.compile.total_us",     []() -> size_t { return (size_t)JitCompiler::GetCompileTotalUs(); } },
+    { L"runtime.jit.cache.loaded",         []() -> size_t { return (size_t)JitCodeCache::GetLoadedCount(); } },
+    { L"runtime.jit.cache.installed",      []() -> size_t { return (size_t)JitCodeCache::GetInstalledCount(); } },
+    { L"runtime.jit.cache.stored",         []() -> size_t { return (size_t)JitCodeCache::GetStoredCount(); } },
+    { L"runtime.jit.cache.rejected",       []() -> size_t { return (size_t)JitCodeCache::GetRejectedCount(); } },
+#endif
     { L"runtime.threads.active",   []() -> size_t { return (size_t)MemoryManager::GetMutatorCount(); } },
     { L"runtime.threads.parked",   []() -> size_t { return (size_t)MemoryManager::GetParkedCount(); } },
     { L"runtime.threads.running",  []() -> size_t { const long a = MemoryManager::GetMutatorCount(),
@@ -5100,6 +5148,159 @@ bool TrapProcessor::SockTcpSetSndBuf(StackProgram* program, size_t* inst, size_t
   return true;
 }
 
+// --- readiness event loop ---
+
+bool TrapProcessor::SockTcpSetNonBlock(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  const bool enable = (bool)PopInt(op_stack, stack_pos);
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+  if(instance && (long)instance[0] > -1) {
+    PushInt(IPSocket::SetNonBlocking((SOCKET)instance[0], enable) ? 1 : 0, op_stack, stack_pos);
+  }
+  else {
+    PushInt(0, op_stack, stack_pos);
+  }
+  return true;
+}
+
+bool TrapProcessor::SockTcpAcceptNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+  if(instance && (long)instance[0] > -1) {
+    SOCKET server = (SOCKET)instance[0];
+    char client_address[SMALL_BUFFER_MAX] = {0};
+    int client_port;
+    // the server socket is non-blocking, so no need to park
+    SOCKET client = IPSocket::Accept(server, client_address, client_port);
+    if((long)client > -1) {
+      const std::wstring wclient_address = BytesToUnicode(client_address);
+      size_t* sock_obj = MemoryManager::AllocateObject(program->GetSocketObjectId(),
+                                                       op_stack, *stack_pos, false);
+      sock_obj[0] = client;
+      sock_obj[1] = (size_t)CreateStringObject(wclient_address, program, op_stack, stack_pos);
+      sock_obj[2] = client_port;
+
+      PushInt((size_t)sock_obj, op_stack, stack_pos);
+      return true;
+    }
+  }
+
+  PushInt(0, op_stack, stack_pos);
+  return true;
+}
+
+bool TrapProcessor::SockTcpReadNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  size_t* array = (size_t*)PopInt(op_stack, stack_pos);
+  const long num = (long)PopInt(op_stack, stack_pos);
+  const INT64_VALUE offset = (INT64_VALUE)PopInt(op_stack, stack_pos);
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+
+  if(array && instance && (long)instance[0] > -1 && offset >= 0 && num >= 0 && offset <= (INT64_VALUE)array[0] && num <= (INT64_VALUE)array[0] - offset) {
+    // never blocks, so the thread is not parked and the array cannot move
+    PushInt(IPSocket::ReadNonBlocking((char*)(array + 3) + offset, (int)num, (SOCKET)instance[0]), op_stack, stack_pos);
+  }
+  else {
+    PushInt(-2, op_stack, stack_pos);
+  }
+
+  return true;
+}
+
+bool TrapProcessor::SockTcpWriteNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  size_t* array = (size_t*)PopInt(op_stack, stack_pos);
+  const long num = (long)PopInt(op_stack, stack_pos);
+  const INT64_VALUE offset = (INT64_VALUE)PopInt(op_stack, stack_pos);
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+
+  if(array && instance && (long)instance[0] > -1 && offset >= 0 && num >= 0 && offset <= (INT64_VALUE)array[0] && num <= (INT64_VALUE)array[0] - offset) {
+    PushInt(IPSocket::WriteNonBlocking((const char*)(array + 3) + offset, (int)num, (SOCKET)instance[0]), op_stack, stack_pos);
+  }
+  else {
+    PushInt(-2, op_stack, stack_pos);
+  }
+
+  return true;
+}
+
+bool TrapProcessor::SockPollCreate(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+  if(instance) {
+    instance[0] = (size_t)SocketPoller::Create();
+  }
+
+  return true;
+}
+
+bool TrapProcessor::SockPollCtl(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  const int events = (int)PopInt(op_stack, stack_pos);
+  size_t* sock_obj = (size_t*)PopInt(op_stack, stack_pos);
+  const int op = (int)PopInt(op_stack, stack_pos);
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+
+  SocketPoller* poller = instance ? (SocketPoller*)instance[0] : nullptr;
+  if(poller && sock_obj && (long)sock_obj[0] > -1) {
+    PushInt(poller->Control(op, (SOCKET)sock_obj[0], events) ? 1 : 0, op_stack, stack_pos);
+  }
+  else {
+    PushInt(0, op_stack, stack_pos);
+  }
+
+  return true;
+}
+
+bool TrapProcessor::SockPollWait(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  const int timeout = (int)PopInt(op_stack, stack_pos);
+  size_t* events_array = (size_t*)PopInt(op_stack, stack_pos);
+  size_t* socks_array = (size_t*)PopInt(op_stack, stack_pos);
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+
+  SocketPoller* poller = instance ? (SocketPoller*)instance[0] : nullptr;
+  if(!poller || !socks_array || !events_array) {
+    PushInt(-1, op_stack, stack_pos);
+    return true;
+  }
+
+  const int max = (int)(socks_array[0] < events_array[0] ? socks_array[0] : events_array[0]);
+  std::vector<SOCKET> socks(max > 0 ? max : 1);
+  std::vector<int> events(max > 0 ? max : 1);
+
+  // the wait blocks; park it and re-root the arrays so that a collection
+  // elsewhere can relocate them
+  PushInt((size_t)socks_array, op_stack, stack_pos);
+  PushInt((size_t)events_array, op_stack, stack_pos);
+  MemoryManager::BeginBlocking();
+  const int count = poller->Wait(socks.data(), events.data(), max, timeout);
+  MemoryManager::EndBlocking();
+  events_array = (size_t*)PopInt(op_stack, stack_pos);
+  socks_array = (size_t*)PopInt(op_stack, stack_pos);
+
+  size_t* socks_ptr = socks_array + 3;
+  size_t* events_ptr = events_array + 3;
+  for(int i = 0; i < count; ++i) {
+    socks_ptr[i] = (size_t)socks[i];
+    events_ptr[i] = (size_t)events[i];
+  }
+  PushInt(count, op_stack, stack_pos);
+
+  return true;
+}
+
+bool TrapProcessor::SockPollClose(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
+{
+  size_t* instance = (size_t*)PopInt(op_stack, stack_pos);
+  if(instance && instance[0]) {
+    delete (SocketPoller*)instance[0];
+    instance[0] = 0;
+  }
+
+  return true;
+}
+
 // --- SSL socket option implementations ---
 
 bool TrapProcessor::SockTcpSslSetKeepAlive(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame)
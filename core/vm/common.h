@@ -378,12 +378,201 @@ struct StackDclr
   long id;
 };
 
+class StackMethod;
+
+/********************************
+ * CallSiteCache class: polymorphic
+ * inline cache of a virtual call site
+ ********************************/
+#define CALL_SITE_CACHE_SIZE 4
+
+class CallSiteCache
+{
+  // an entry is claimed through 'count' and published by storing its class
+  // last, so a reader that sees the class also sees the method
+  std::atomic<StackClass*> classes[CALL_SITE_CACHE_SIZE];
+  StackMethod* methods[CALL_SITE_CACHE_SIZE];
+  std::atomic<long> count;
+
+ public:
+  CallSiteCache() : count(0) {
+    for(int i = 0; i < CALL_SITE_CACHE_SIZE; ++i) {
+      classes[i].store(nullptr, std::memory_order_relaxed);
+      methods[i] = nullptr;
+    }
+  }
+
+  inline StackMethod* Lookup(StackClass* cls) {
+    // a claimed but unpublished entry still has a null class
+    if(!cls) {
+      return nullptr;
+    }
+
+    for(int i = 0; i < CALL_SITE_CACHE_SIZE; ++i) {
+      if(classes[i].load(std::memory_order_acquire) == cls) {
+        return methods[i];
+      }
+    }
+
+    return nullptr;
+  }
+
+  // once full the site is megamorphic and misses go to the class lookup
+  inline void Add(StackClass* cls, StackMethod* mthd) {
+    if(IsMegamorphic()) {
+      return;
+    }
+
+    const long slot = count.fetch_add(1, std::memory_order_relaxed);
+    if(slot < CALL_SITE_CACHE_SIZE) {
+      methods[slot] = mthd;
+      classes[slot].store(cls, std::memory_order_release);
+    }
+  }
+
+  inline bool IsMegamorphic() {
+    return count.load(std::memory_order_relaxed) >= CALL_SITE_CACHE_SIZE;
+  }
+};
+
+/********************************
+ * Interpreter dispatch opcodes.
+ * Hot instructions get their own
+ * handler in the interpreter loop,
+ * everything else goes through
+ * instr_dispatch[]. Superinstructions
+ * are set by the loader on the first
+ * instruction of a fused sequence.
+ ********************************/
+enum DispatchOp {
+  OP_DISPATCH = 0,
+  OP_LOAD_INT_LIT,
+  OP_LOAD_CHAR_LIT,
+  OP_LOAD_LOCL_INT_VAR,
+  OP_STOR_LOCL_INT_VAR,
+  OP_COPY_LOCL_INT_VAR,
+  OP_ADD_INT,
+  OP_SUB_INT,
+  OP_MUL_INT,
+  OP_EQL_INT,
+  OP_NEQL_INT,
+  OP_LES_INT,
+  OP_GTR_INT,
+  OP_LES_EQL_INT,
+  OP_GTR_EQL_INT,
+  OP_AND_INT,
+  OP_OR_INT,
+  OP_BIT_AND_INT,
+  OP_BIT_OR_INT,
+  OP_BIT_XOR_INT,
+  OP_SHL_INT,
+  OP_SHR_INT,
+  OP_ADD_FLOAT,
+  OP_SUB_FLOAT,
+  OP_MUL_FLOAT,
+  OP_EQL_FLOAT,
+  OP_NEQL_FLOAT,
+  OP_LES_FLOAT,
+  OP_GTR_FLOAT,
+  OP_LES_EQL_FLOAT,
+  OP_GTR_EQL_FLOAT,
+  OP_LBL,
+  OP_JMP,
+  // superinstructions
+  OP_LIT_LOCL_INT,          // LOAD_INT_LIT, LOAD_LOCL_INT_VAR
+  OP_LOCL_LOCL_INT,         // LOAD_LOCL_INT_VAR, LOAD_LOCL_INT_VAR
+  OP_LIT_LOCL_ADD_INT,      // LOAD_INT_LIT, LOAD_LOCL_INT_VAR, ADD_INT
+  OP_LIT_LOCL_SUB_INT,      // LOAD_INT_LIT, LOAD_LOCL_INT_VAR, SUB_INT
+  OP_LIT_LOCL_MUL_INT,      // LOAD_INT_LIT, LOAD_LOCL_INT_VAR, MUL_INT
+  OP_LIT_LOCL_ADD_STOR_INT, // ... ADD_INT, STOR_LOCL_INT_VAR ('i += c')
+  OP_LIT_LOCL_SUB_STOR_INT, // ... SUB_INT, STOR_LOCL_INT_VAR ('i -= c')
+  OP_EQL_INT_JMP,           // <compare>, conditional JMP
+  OP_NEQL_INT_JMP,
+  OP_LES_INT_JMP,
+  OP_GTR_INT_JMP,
+  OP_LES_EQL_INT_JMP,
+  OP_GTR_EQL_INT_JMP,
+  OP_END
+};
+
+inline DispatchOp ToDispatchOp(InstructionType type) {
+  switch(type) {
+  case LOAD_INT_LIT:
+    return OP_LOAD_INT_LIT;
+  case LOAD_CHAR_LIT:
+    return OP_LOAD_CHAR_LIT;
+  case LOAD_LOCL_INT_VAR:
+    return OP_LOAD_LOCL_INT_VAR;
+  case STOR_LOCL_INT_VAR:
+    return OP_STOR_LOCL_INT_VAR;
+  case COPY_LOCL_INT_VAR:
+    return OP_COPY_LOCL_INT_VAR;
+  case ADD_INT:
+    return OP_ADD_INT;
+  case SUB_INT:
+    return OP_SUB_INT;
+  case MUL_INT:
+    return OP_MUL_INT;
+  case EQL_INT:
+    return OP_EQL_INT;
+  case NEQL_INT:
+    return OP_NEQL_INT;
+  case LES_INT:
+    return OP_LES_INT;
+  case GTR_INT:
+    return OP_GTR_INT;
+  case LES_EQL_INT:
+    return OP_LES_EQL_INT;
+  case GTR_EQL_INT:
+    return OP_GTR_EQL_INT;
+  case AND_INT:
+    return OP_AND_INT;
+  case OR_INT:
+    return OP_OR_INT;
+  case BIT_AND_INT:
+    return OP_BIT_AND_INT;
+  case BIT_OR_INT:
+    return OP_BIT_OR_INT;
+  case BIT_XOR_INT:
+    return OP_BIT_XOR_INT;
+  case SHL_INT:
+    return OP_SHL_INT;
+  case SHR_INT:
+    return OP_SHR_INT;
+  case ADD_FLOAT:
+    return OP_ADD_FLOAT;
+  case SUB_FLOAT:
+    return OP_SUB_FLOAT;
+  case MUL_FLOAT:
+    return OP_MUL_FLOAT;
+  case EQL_FLOAT:
+    return OP_EQL_FLOAT;
+  case NEQL_FLOAT:
+    return OP_NEQL_FLOAT;
+  case LES_FLOAT:
+    return OP_LES_FLOAT;
+  case GTR_FLOAT:
+    return OP_GTR_FLOAT;
+  case LES_EQL_FLOAT:
+    return OP_LES_EQL_FLOAT;
+  case GTR_EQL_FLOAT:
+    return OP_GTR_EQL_FLOAT;
+  case LBL:
+    return OP_LBL;
+  case JMP:
+    return OP_JMP;
+  default:
+    return OP_DISPATCH;
+  }
+}
+
 /********************************
  * StackInstr class
  ********************************/
 class StackInstr
 {
   InstructionType type;
+  DispatchOp dispatch_op;
   long operand;
   union {
     long operand2;
@@ -393,53 +582,66 @@ class StackInstr
   long operand3;
   long native_offset;
   int line_num;
+  CallSiteCache* call_cache;
 
  public:
-  StackInstr() : type(END_STMTS), operand(0), operand3(0), native_offset(0), line_num(-1) {
+  StackInstr() : type(END_STMTS), dispatch_op(OP_DISPATCH), operand(0), operand3(0), native_offset(0), line_num(-1), call_cache(nullptr) {
     alt_operand.operand2 = 0;
   }
 
   StackInstr(int l, INT64_VALUE v) {
     line_num = l;
     type = LOAD_INT_LIT;
+    dispatch_op = OP_LOAD_INT_LIT;
     alt_operand.int64_operand = v;
+    call_cache = nullptr;
   }
 
   StackInstr(int l, InstructionType t) {
     line_num = l;
     type = t;
+    dispatch_op = ToDispatchOp(t);
     operand = operand3 = native_offset = 0;
+    call_cache = nullptr;
   }
 
   StackInstr(int l, InstructionType t, long o) {
     line_num = l;
     type = t;
+    dispatch_op = ToDispatchOp(t);
     operand = o;
     operand3 = native_offset = 0;
+    call_cache = nullptr;
   }
 
   StackInstr(int l, InstructionType t, FLOAT_VALUE f) {
     line_num = l;
     type = t;
+    dispatch_op = ToDispatchOp(t);
     alt_operand.float_operand = f;
     operand = operand3 = native_offset = 0;
+    call_cache = nullptr;
   }
 
   StackInstr(int l, InstructionType t, long o1, long o2) {
     line_num = l;
     type = t;
+    dispatch_op = ToDispatchOp(t);
     operand = o1;
     alt_operand.operand2 = o2;
     operand3 = native_offset = 0;
+    call_cache = nullptr;
   }
 
   StackInstr(int l, InstructionType t, long o1, long o2, long o3) {
     line_num = l;
     type = t;
+    dispatch_op = ToDispatchOp(t);
     operand = o1;
     alt_operand.operand2 = o2;
     operand3 = o3;
     native_offset = 0;
+    call_cache = nullptr;
   }
 
   ~StackInstr() {
@@ -479,6 +681,17 @@ class StackInstr
 
   inline void SetType(InstructionType t) {
     type = t;
+    dispatch_op = ToDispatchOp(t);
+  }
+
+  // interpreter handler; differs from ToDispatchOp(type) only for the first
+  // instruction of a superinstruction
+  inline DispatchOp GetDispatchOp() const {
+    return dispatch_op;
+  }
+
+  inline void SetDispatchOp(DispatchOp o) {
+    dispatch_op = o;
   }
 
   inline void SetOperand3(long o3) {
@@ -488,6 +701,34 @@ class StackInstr
   inline void SetOffset(long o) {
     native_offset = o;
   }
+
+  // virtual call site: method cached for the receiver class, or nullptr
+  inline StackMethod* LookupCall(StackClass* cls) {
+    CallSiteCache* cache = std::atomic_ref<CallSiteCache*>(call_cache).load(std::memory_order_acquire);
+    return cache ? cache->Lookup(cls) : nullptr;
+  }
+
+  // records a resolved virtual call; the cache is created by the first thread
+  // to get here
+  void CacheCall(StackClass* cls, StackMethod* mthd) {
+    std::atomic_ref<CallSiteCache*> cache_ref(call_cache);
+    CallSiteCache* cache = cache_ref.load(std::memory_order_acquire);
+    if(!cache) {
+      CallSiteCache* new_cache = new CallSiteCache;
+      if(cache_ref.compare_exchange_strong(cache, new_cache, std::memory_order_acq_rel)) {
+        cache = new_cache;
+      }
+      else {
+        delete new_cache;
+      }
+    }
+    cache->Add(cls, mthd);
+  }
+
+  inline void ReleaseCallCache() {
+    delete call_cache;
+    call_cache = nullptr;
+  }
 };
 
 /********************************
@@ -503,6 +744,8 @@ class NativeCode {
 
   long size;
   FLOAT_VALUE* floats;
+  // on-stack replacement entry points: loop-header LBL index -> code offset
+  std::unordered_map<long, long> osr_entries;
   
  public:
 #if defined(_ARM64) || defined(_M_ARM64)
@@ -561,6 +804,19 @@ class NativeCode {
   inline FLOAT_VALUE* GetFloats() const {
     return floats;
   }
+
+  inline void AddOsrEntry(long index, long offset) {
+    osr_entries[index] = offset;
+  }
+
+  // code offset of the entry that resumes at the given loop header, or -1
+  inline long GetOsrEntry(long index) const {
+    std::unordered_map<long, long>::const_iterator result = osr_entries.find(index);
+    if(result != osr_entries.end()) {
+      return result->second;
+    }
+    return -1;
+  }
 };
 
 /********************************
@@ -584,6 +840,8 @@ class StackMethod {
   std::atomic<NativeCode*> native_code;
   std::atomic<long> jit_call_count;
   std::atomic<int> jit_state;
+  // loop back-edges taken while interpreted (on-stack replacement trigger)
+  std::atomic<long> jit_loop_count;
   MemoryType rtrn_type;
   StackDclr** dclrs;
   long num_dclrs;
@@ -601,6 +859,7 @@ class StackMethod {
     native_code.store(nullptr, std::memory_order_relaxed);
     jit_call_count.store(0, std::memory_order_relaxed);
     jit_state.store(JIT_NONE, std::memory_order_relaxed);
+    jit_loop_count.store(0, std::memory_order_relaxed);
     dclrs = d;
     num_dclrs = nd;
     param_count = p;
@@ -631,6 +890,11 @@ class StackMethod {
     }
 
     // contiguous array - single deallocation
+    if(instrs) {
+      for(int i = 0; i < instr_count; ++i) {
+        instrs[i].ReleaseCallCache();
+      }
+    }
     delete[] instrs;
     instrs = nullptr;
   }
@@ -715,6 +979,22 @@ class StackMethod {
     return jit_call_count.fetch_add(1, std::memory_order_relaxed);
   }
 
+  // Counts a loop back-edge; true once 'threshold' have been taken. A plain
+  // load/store rather than fetch_add: a lost update between threads only delays
+  // the trigger, and the interpreter's back-edge path stays free of locked ops.
+  inline bool CountJitLoop(long threshold) {
+    const long count = jit_loop_count.load(std::memory_order_relaxed);
+    if(count >= threshold) {
+      return true;
+    }
+    jit_loop_count.store(count + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  inline long GetJitLoopCount() const {
+    return jit_loop_count.load(std::memory_order_relaxed);
+  }
+
   inline int GetJitState() const {
     return jit_state.load(std::memory_order_acquire);
   }
@@ -817,6 +1097,12 @@ class StackClass {
     }
   };
   std::unordered_map<virtual_key_pair, StackMethod*, virtual_key_pair_hash> virtual_methods;
+  // virtual_methods is filled by whichever thread first misses a call site
+#ifdef _WIN32
+  CRITICAL_SECTION virtual_cs;
+#else
+  pthread_mutex_t virtual_mutex;
+#endif
   
   long InitializeClassMemory(long size) {
     if(size > 0) {
@@ -845,9 +1131,20 @@ class StackClass {
     cls_space = InitializeClassMemory(cspace);
     inst_space = ispace;
     is_debug = d;
+#ifdef _WIN32
+    InitializeCriticalSection(&virtual_cs);
+#else
+    pthread_mutex_init(&virtual_mutex, nullptr);
+#endif
   }
 
   ~StackClass() {
+#ifdef _WIN32
+    DeleteCriticalSection(&virtual_cs);
+#else
+    pthread_mutex_destroy(&virtual_mutex);
+#endif
+
     // clean up
     if(cls_dclrs) {
       for(int i = 0; i < cls_num_dclrs; ++i) {
@@ -1103,18 +1400,38 @@ class StackClass {
 
   StackMethod* GetVirtualMethod(size_t virtual_cls_id, size_t virtual_mthd_id) {
     const auto virtual_key = std::make_pair(virtual_cls_id, virtual_mthd_id);
+    StackMethod* mthd = nullptr;
+#ifdef _WIN32
+    MUTEX_LOCK(&virtual_cs);
+#else
+    MUTEX_LOCK(&virtual_mutex);
+#endif
     const auto result = virtual_methods.find(virtual_key);
     if(result != virtual_methods.end()) {
-      return result->second;
+      mthd = result->second;
     }
+#ifdef _WIN32
+    MUTEX_UNLOCK(&virtual_cs);
+#else
+    MUTEX_UNLOCK(&virtual_mutex);
+#endif
 
-    return nullptr;
+    return mthd;
   }
 
   void AddVirutalMethod(size_t virtual_cls_id, size_t virtual_mthd_id, StackMethod* mthd) {
-    // TODO: thread safe?
     const virtual_key_pair virtual_key = std::make_pair(virtual_cls_id, virtual_mthd_id);
+#ifdef _WIN32
+    MUTEX_LOCK(&virtual_cs);
+#else
+    MUTEX_LOCK(&virtual_mutex);
+#endif
     virtual_methods.insert(std::pair<virtual_key_pair, StackMethod*>(virtual_key, mthd));
+#ifdef _WIN32
+    MUTEX_UNLOCK(&virtual_cs);
+#else
+    MUTEX_UNLOCK(&virtual_mutex);
+#endif
   }
 };
 
@@ -2202,6 +2519,15 @@ class TrapProcessor {
   static bool SockTcpSetConnTimeout(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
   static bool SockTcpSetRcvBuf(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
   static bool SockTcpSetSndBuf(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  // readiness event loop
+  static bool SockTcpSetNonBlock(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockTcpAcceptNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockTcpReadNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockTcpWriteNb(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockPollCreate(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockPollCtl(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockPollWait(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
+  static bool SockPollClose(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
   // SSL socket options
   static bool SockTcpSslSetKeepAlive(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
   static bool SockTcpSslSetNoDelay(StackProgram* program, size_t* inst, size_t*& op_stack, size_t*& stack_pos, StackFrame* frame);
@@ -167,6 +167,7 @@ void StackInterpreter::Execute(size_t* op_stack, size_t* stack_pos, long i, Stac
   unsigned safepoint_ticks = 0;
 
   // execute using dispatch table
+#ifdef _DEBUGGER
   do {
     if((++safepoint_ticks & 0x3FF) == 0) {
       MemoryManager::SafePoint();
@@ -174,7 +175,6 @@ void StackInterpreter::Execute(size_t* op_stack, size_t* stack_pos, long i, Stac
     StackInstr* instr = &instrs[ip++];
     ctx.instr = instr;
 
-#ifdef _DEBUGGER
     debugger->ProcessInstruction(instr, ip, call_stack, (*call_stack_pos), (*stack_frame));
     DispatchResult result = instr_dispatch[instr->GetType()](ctx);
     if(result == DispatchResult::RETURN_JIT) {
@@ -183,214 +183,397 @@ void StackInterpreter::Execute(size_t* op_stack, size_t* stack_pos, long i, Stac
     if(result == DispatchResult::HALT) {
       break;
     }
+
+    // check for try error recovery
+    long recovery_ip = CheckTryRecovery();
+    if(recovery_ip >= 0) {
+      ip = recovery_ip;
+      ctx.instrs = (*stack_frame)->method->GetInstructions();
+    }
+
+    // instrs may have changed from method calls
+    instrs = ctx.instrs;
+  }
+  while(!halt);
 #else
-    // Inline hot opcodes for performance — these use 'continue' to skip
-    // the recovery check (they can't trigger errors or change instrs).
-    // The default dispatch path falls through to the recovery check below.
-    switch(instr->GetType()) {
-    case LOAD_INT_LIT:
+  // Hot opcodes and superinstructions (see DispatchOp) run inline. They can't
+  // trigger errors or change instrs, so they skip the recovery check; the rest
+  // go through instr_dispatch[]. With _THREADED_DISPATCH every handler ends in
+  // its own indirect jump to the next one (computed goto), otherwise the
+  // handlers are the cases of a switch.
+#ifdef _THREADED_DISPATCH
+  static void* const dispatch_labels[] = {
+    &&L_OP_DISPATCH,
+    &&L_OP_LOAD_INT_LIT,
+    &&L_OP_LOAD_CHAR_LIT,
+    &&L_OP_LOAD_LOCL_INT_VAR,
+    &&L_OP_STOR_LOCL_INT_VAR,
+    &&L_OP_COPY_LOCL_INT_VAR,
+    &&L_OP_ADD_INT,
+    &&L_OP_SUB_INT,
+    &&L_OP_MUL_INT,
+    &&L_OP_EQL_INT,
+    &&L_OP_NEQL_INT,
+    &&L_OP_LES_INT,
+    &&L_OP_GTR_INT,
+    &&L_OP_LES_EQL_INT,
+    &&L_OP_GTR_EQL_INT,
+    &&L_OP_AND_INT,
+    &&L_OP_OR_INT,
+    &&L_OP_BIT_AND_INT,
+    &&L_OP_BIT_OR_INT,
+    &&L_OP_BIT_XOR_INT,
+    &&L_OP_SHL_INT,
+    &&L_OP_SHR_INT,
+    &&L_OP_ADD_FLOAT,
+    &&L_OP_SUB_FLOAT,
+    &&L_OP_MUL_FLOAT,
+    &&L_OP_EQL_FLOAT,
+    &&L_OP_NEQL_FLOAT,
+    &&L_OP_LES_FLOAT,
+    &&L_OP_GTR_FLOAT,
+    &&L_OP_LES_EQL_FLOAT,
+    &&L_OP_GTR_EQL_FLOAT,
+    &&L_OP_LBL,
+    &&L_OP_JMP,
+    &&L_OP_LIT_LOCL_INT,
+    &&L_OP_LOCL_LOCL_INT,
+    &&L_OP_LIT_LOCL_ADD_INT,
+    &&L_OP_LIT_LOCL_SUB_INT,
+    &&L_OP_LIT_LOCL_MUL_INT,
+    &&L_OP_LIT_LOCL_ADD_STOR_INT,
+    &&L_OP_LIT_LOCL_SUB_STOR_INT,
+    &&L_OP_EQL_INT_JMP,
+    &&L_OP_NEQL_INT_JMP,
+    &&L_OP_LES_INT_JMP,
+    &&L_OP_GTR_INT_JMP,
+    &&L_OP_LES_EQL_INT_JMP,
+    &&L_OP_GTR_EQL_INT_JMP
+  };
+  static_assert(sizeof(dispatch_labels) / sizeof(dispatch_labels[0]) == OP_END,
+                "Dispatch labels must match DispatchOp enum count");
+
+#define DISPATCH_CASE(op) L_##op:
+#define DISPATCH_DEFAULT L_OP_DISPATCH:
+#define DISPATCH_NEXT() \
+  if((++safepoint_ticks & 0x3FF) == 0) { \
+    MemoryManager::SafePoint(); \
+  } \
+  instr = &instrs[ip++]; \
+  goto *dispatch_labels[instr->GetDispatchOp()]
+#define DISPATCH_TAIL() goto dispatch_tail
+
+  StackInstr* instr;
+  long cmp_value;
+  DISPATCH_NEXT();
+  {
+#else
+#define DISPATCH_CASE(op) case op:
+#define DISPATCH_DEFAULT default:
+#define DISPATCH_NEXT() continue
+#define DISPATCH_TAIL() break
+
+  long cmp_value;
+  do {
+    if((++safepoint_ticks & 0x3FF) == 0) {
+      MemoryManager::SafePoint();
+    }
+    StackInstr* instr = &instrs[ip++];
+
+    switch(instr->GetDispatchOp()) {
+#endif
+    DISPATCH_CASE(OP_LOAD_INT_LIT)
       op_stack[(*stack_pos)++] = (size_t)instr->GetInt64Operand();
-      continue;
+      DISPATCH_NEXT();
 
-    case LOAD_LOCL_INT_VAR:
+    DISPATCH_CASE(OP_LOAD_LOCL_INT_VAR)
       op_stack[(*stack_pos)++] = (*stack_frame)->mem[instr->GetOperand() + 1];
-      continue;
+      DISPATCH_NEXT();
 
-    case STOR_LOCL_INT_VAR:
+    DISPATCH_CASE(OP_STOR_LOCL_INT_VAR)
       (*stack_frame)->mem[instr->GetOperand() + 1] = op_stack[--(*stack_pos)];
-      continue;
+      DISPATCH_NEXT();
 
-    case COPY_LOCL_INT_VAR:
+    DISPATCH_CASE(OP_COPY_LOCL_INT_VAR)
       (*stack_frame)->mem[instr->GetOperand() + 1] = op_stack[(*stack_pos) - 1];
-      continue;
+      DISPATCH_NEXT();
 
-    case ADD_INT: {
+    DISPATCH_CASE(OP_ADD_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] + (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
-    case SUB_INT: {
+    DISPATCH_CASE(OP_SUB_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] - (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
-    case MUL_INT: {
+    DISPATCH_CASE(OP_MUL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] * (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
-    case LOAD_CHAR_LIT:
+    DISPATCH_CASE(OP_LOAD_CHAR_LIT)
       op_stack[(*stack_pos)++] = (size_t)instr->GetOperand();
-      continue;
+      DISPATCH_NEXT();
 
     // integer comparisons (pop 2, push 0/1)
-    case EQL_INT: {
+    DISPATCH_CASE(OP_EQL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] == (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case NEQL_INT: {
+    DISPATCH_CASE(OP_NEQL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] != (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case LES_INT: {
+    DISPATCH_CASE(OP_LES_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] < (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case GTR_INT: {
+    DISPATCH_CASE(OP_GTR_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] > (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case LES_EQL_INT: {
+    DISPATCH_CASE(OP_LES_EQL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] <= (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case GTR_EQL_INT: {
+    DISPATCH_CASE(OP_GTR_EQL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] >= (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
     // logical ops
-    case AND_INT: {
+    DISPATCH_CASE(OP_AND_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] && (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case OR_INT: {
+    DISPATCH_CASE(OP_OR_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (INT64_VALUE)op_stack[sp - 1] || (INT64_VALUE)op_stack[sp - 2];
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
     // bitwise ops
-    case BIT_AND_INT: {
+    DISPATCH_CASE(OP_BIT_AND_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] & (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case BIT_OR_INT: {
+    DISPATCH_CASE(OP_BIT_OR_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] | (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case BIT_XOR_INT: {
+    DISPATCH_CASE(OP_BIT_XOR_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] ^ (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
     // shift ops
-    case SHL_INT: {
+    DISPATCH_CASE(OP_SHL_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] << (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case SHR_INT: {
+    DISPATCH_CASE(OP_SHR_INT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = (size_t)((INT64_VALUE)op_stack[sp - 1] >> (INT64_VALUE)op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
     // float arithmetic (operands bit-stored in op_stack slots; left=sp-1, right=sp-2,
     // matching AddFloat/SubFloat/MulFloat). DIV_FLOAT is NOT inlined — its
     // divide-by-zero path needs the recovery check below, same as DIV_INT/MOD_INT.
-    case ADD_FLOAT: {
+    DISPATCH_CASE(OP_ADD_FLOAT) {
       const size_t sp = *stack_pos;
       *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]) =
         *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) + *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case SUB_FLOAT: {
+    DISPATCH_CASE(OP_SUB_FLOAT) {
       const size_t sp = *stack_pos;
       *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]) =
         *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) - *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case MUL_FLOAT: {
+    DISPATCH_CASE(OP_MUL_FLOAT) {
       const size_t sp = *stack_pos;
       *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]) =
         *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) * *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
     // float comparisons (pop 2, push 0/1)
-    case LES_FLOAT: {
+    DISPATCH_CASE(OP_LES_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) < *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case GTR_FLOAT: {
+    DISPATCH_CASE(OP_GTR_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) > *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case LES_EQL_FLOAT: {
+    DISPATCH_CASE(OP_LES_EQL_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) <= *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case GTR_EQL_FLOAT: {
+    DISPATCH_CASE(OP_GTR_EQL_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) >= *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case EQL_FLOAT: {
+    DISPATCH_CASE(OP_EQL_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) == *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
-    case NEQL_FLOAT: {
+    DISPATCH_CASE(OP_NEQL_FLOAT) {
       const size_t sp = *stack_pos;
       op_stack[sp - 2] = *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 1]) != *reinterpret_cast<FLOAT_VALUE*>(&op_stack[sp - 2]);
       *stack_pos = sp - 1;
-      continue;
+      DISPATCH_NEXT();
     }
 
-    case LBL:
-      continue;
+    DISPATCH_CASE(OP_LBL)
+      DISPATCH_NEXT();
 
-    case JMP:
-      if(instr->GetOperand2() < 0) {
+    DISPATCH_CASE(OP_JMP)
+      if(instr->GetOperand2() < 0 || (INT64_VALUE)op_stack[--(*stack_pos)] == instr->GetOperand2()) {
+#ifndef _NO_JIT
+        // loop back-edge: may finish the call in native code (on-stack
+        // replacement); then fall through to the recovery check below
+        if(instr->GetOperand() < ip && ProcessOsrEntry(instr->GetOperand(), ip, op_stack, stack_pos)) {
+          DISPATCH_TAIL();
+        }
+#endif
         ip = instr->GetOperand();
       }
-      else if((INT64_VALUE)op_stack[--(*stack_pos)] == instr->GetOperand2()) {
+      DISPATCH_NEXT();
+
+    //
+    // superinstructions: 'instr' is the first instruction of the sequence and
+    // the others follow it unchanged (see Loader::FuseInstructions)
+    //
+    DISPATCH_CASE(OP_LIT_LOCL_INT) {
+      const size_t sp = *stack_pos;
+      op_stack[sp] = (size_t)instr->GetInt64Operand();
+      op_stack[sp + 1] = (*stack_frame)->mem[instrs[ip].GetOperand() + 1];
+      *stack_pos = sp + 2;
+      ip += 1;
+      DISPATCH_NEXT();
+    }
+
+    DISPATCH_CASE(OP_LOCL_LOCL_INT) {
+      const size_t sp = *stack_pos;
+      size_t* mem = (*stack_frame)->mem;
+      op_stack[sp] = mem[instr->GetOperand() + 1];
+      op_stack[sp + 1] = mem[instrs[ip].GetOperand() + 1];
+      *stack_pos = sp + 2;
+      ip += 1;
+      DISPATCH_NEXT();
+    }
+
+    // local (left) op literal (right)
+    DISPATCH_CASE(OP_LIT_LOCL_ADD_INT)
+      op_stack[(*stack_pos)++] = (size_t)((INT64_VALUE)(*stack_frame)->mem[instrs[ip].GetOperand() + 1] + instr->GetInt64Operand());
+      ip += 2;
+      DISPATCH_NEXT();
+
+    DISPATCH_CASE(OP_LIT_LOCL_SUB_INT)
+      op_stack[(*stack_pos)++] = (size_t)((INT64_VALUE)(*stack_frame)->mem[instrs[ip].GetOperand() + 1] - instr->GetInt64Operand());
+      ip += 2;
+      DISPATCH_NEXT();
+
+    DISPATCH_CASE(OP_LIT_LOCL_MUL_INT)
+      op_stack[(*stack_pos)++] = (size_t)((INT64_VALUE)(*stack_frame)->mem[instrs[ip].GetOperand() + 1] * instr->GetInt64Operand());
+      ip += 2;
+      DISPATCH_NEXT();
+
+    DISPATCH_CASE(OP_LIT_LOCL_ADD_STOR_INT) {
+      size_t* mem = (*stack_frame)->mem;
+      mem[instrs[ip + 2].GetOperand() + 1] = (size_t)((INT64_VALUE)mem[instrs[ip].GetOperand() + 1] + instr->GetInt64Operand());
+      ip += 3;
+      DISPATCH_NEXT();
+    }
+
+    DISPATCH_CASE(OP_LIT_LOCL_SUB_STOR_INT) {
+      size_t* mem = (*stack_frame)->mem;
+      mem[instrs[ip + 2].GetOperand() + 1] = (size_t)((INT64_VALUE)mem[instrs[ip].GetOperand() + 1] - instr->GetInt64Operand());
+      ip += 3;
+      DISPATCH_NEXT();
+    }
+
+    // integer compare and conditional jump
+    DISPATCH_CASE(OP_EQL_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] == (INT64_VALUE)op_stack[(*stack_pos) - 2];
+      goto cmp_jmp;
+    DISPATCH_CASE(OP_NEQL_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] != (INT64_VALUE)op_stack[(*stack_pos) - 2];
+      goto cmp_jmp;
+    DISPATCH_CASE(OP_LES_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] < (INT64_VALUE)op_stack[(*stack_pos) - 2];
+      goto cmp_jmp;
+    DISPATCH_CASE(OP_GTR_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] > (INT64_VALUE)op_stack[(*stack_pos) - 2];
+      goto cmp_jmp;
+    DISPATCH_CASE(OP_LES_EQL_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] <= (INT64_VALUE)op_stack[(*stack_pos) - 2];
+      goto cmp_jmp;
+    DISPATCH_CASE(OP_GTR_EQL_INT_JMP)
+      cmp_value = (INT64_VALUE)op_stack[(*stack_pos) - 1] >= (INT64_VALUE)op_stack[(*stack_pos) - 2];
+    cmp_jmp:
+      (*stack_pos) -= 2;
+      instr = &instrs[ip++];
+      if(cmp_value == instr->GetOperand2()) {
+#ifndef _NO_JIT
+        if(instr->GetOperand() < ip && ProcessOsrEntry(instr->GetOperand(), ip, op_stack, stack_pos)) {
+          DISPATCH_TAIL();
+        }
+#endif
         ip = instr->GetOperand();
       }
-      continue;
+      DISPATCH_NEXT();
 
-    default: {
+    DISPATCH_DEFAULT {
+      ctx.instr = instr;
       DispatchResult result = instr_dispatch[instr->GetType()](ctx);
       if(result == DispatchResult::RETURN_JIT) {
         return;
@@ -399,8 +582,10 @@ void StackInterpreter::Execute(size_t* op_stack, size_t* stack_pos, long i, Stac
         goto loop_exit;
       }
     }
+#ifdef _THREADED_DISPATCH
+  dispatch_tail:
+#else
     }
-    // Only reached by default dispatch path (inlined opcodes skip via continue)
 #endif
     // check for try error recovery
     long recovery_ip = CheckTryRecovery();
@@ -411,9 +596,22 @@ void StackInterpreter::Execute(size_t* op_stack, size_t* stack_pos, long i, Stac
 
     // instrs may have changed from method calls
     instrs = ctx.instrs;
+#ifdef _THREADED_DISPATCH
+    if(halt) {
+      goto loop_exit;
+    }
+    DISPATCH_NEXT();
+  }
+#else
   }
   while(!halt);
-#ifndef _DEBUGGER
+#endif
+
+#undef DISPATCH_CASE
+#undef DISPATCH_DEFAULT
+#undef DISPATCH_NEXT
+#undef DISPATCH_TAIL
+
 loop_exit: ;
 #endif
 
@@ -2196,6 +2394,64 @@ void __attribute__((noinline)) StackInterpreter::CheckAutoJit(StackMethod* calle
     // success: PatchCallSites already set operand3=1 on all call sites
   }
 }
+
+/********************************
+ * On-stack replacement: counts the running method's loop back-edges and, once
+ * they cross JIT_OSR_THRESHOLD, compiles it and finishes this call in native
+ * code from the loop header at 'target'. The native entry copies the frame's
+ * locals into its stack slots; the operand stack carries over as is (it holds
+ * nothing of this method's at a loop header). Returns true if the call ran to
+ * completion: 'ip' then points at the method's trailing RTRN, which unwinds the
+ * frame exactly as an interpreted return would.
+ ********************************/
+#ifdef _MSC_VER
+__declspec(noinline) bool StackInterpreter::ProcessOsrEntry(long target, long &ip, size_t* &op_stack, size_t* &stack_pos)
+#else
+bool __attribute__((noinline)) StackInterpreter::ProcessOsrEntry(long target, long &ip, size_t* &op_stack, size_t* &stack_pos)
+#endif
+{
+  StackFrame* frame = *stack_frame;
+  StackMethod* method = frame->method;
+  if(method->GetJitState() == StackMethod::JIT_FAILED || !method->CountJitLoop(JIT_OSR_THRESHOLD)) {
+    return false;
+  }
+
+  // native code ignores try blocks; a handler this call installed would resume
+  // it in the interpreter with locals the native code never wrote back
+  if(HasTryHandler() && try_handler_call_stack_pos[try_handler_pos - 1] == *call_stack_pos) {
+    return false;
+  }
+
+  const long rtrn_ip = method->GetInstructionCount() - 1;
+  if(rtrn_ip < 0 || method->GetInstruction(rtrn_ip)->GetType() != RTRN) {
+    return false;
+  }
+
+  if(!JitCompiler::TryAutoJitCompile(method)) {
+    return false;
+  }
+
+  // null until the compiler thread publishes the method
+  NativeCode* native_code = method->GetNativeCode();
+  const long entry = native_code ? native_code->GetOsrEntry(target) : -1;
+  if(entry < 0) {
+    return false;
+  }
+
+  JitRuntime jit_executor;
+  const long status = jit_executor.Execute(method, (size_t*)frame->mem[0], op_stack, stack_pos, call_stack, call_stack_pos, frame, entry);
+  // the native frame is gone; the GC must not scan it through this frame
+  frame->jit_mem = nullptr;
+  if(status < 0) {
+    if(!TryErrorRecovery(stack_pos)) {
+      ProcessJitError(status, method);
+    }
+    return true;
+  }
+
+  ip = rtrn_ip;
+  return true;
+}
 #endif
 
 /********************************
@@ -2278,6 +2534,7 @@ StackMethod* __attribute__((noinline, cold)) StackInterpreter::ResolveVirtualMet
 #endif
   }
 
+  StackClass* receiver_class = concrete_class;
   StackMethod* virtual_call = concrete_class->GetVirtualMethod(instr->GetOperand(), instr->GetOperand2());
   if(!virtual_call) {
     const std::wstring qualified_method_name = concrete_call->GetName();
@@ -2290,11 +2547,12 @@ StackMethod* __attribute__((noinline, cold)) StackInterpreter::ResolveVirtualMet
       method_name = concrete_class->GetName() + method_ending;
       virtual_call = concrete_class->GetMethod(method_name);
     }
-    concrete_class->AddVirutalMethod(instr->GetOperand(), instr->GetOperand2(), virtual_call);
+    receiver_class->AddVirutalMethod(instr->GetOperand(), instr->GetOperand2(), virtual_call);
   }
 #ifdef _DEBUG
   assert(virtual_call);
 #endif
+  instr->CacheCall(receiver_class, virtual_call);
   return virtual_call;
 }
 
@@ -2310,9 +2568,10 @@ void StackInterpreter::ProcessMethodCall(StackInstr* instr, StackInstr* &instrs,
   // make call
   StackMethod* concrete_call = program->GetClass(instr->GetOperand())->GetMethod(instr->GetOperand2());
 
-  // virtual method call -- resolve in cold path
+  // virtual method call -- call site's inline cache, resolve in cold path on a miss
   if(concrete_call->IsVirtual()) {
-    concrete_call = ResolveVirtualMethod(concrete_call, instance, instr, instrs, ip, stack_pos);
+    StackMethod* cached_call = instr->LookupCall(MemoryManager::GetClass(instance));
+    concrete_call = cached_call ? cached_call : ResolveVirtualMethod(concrete_call, instance, instr, instrs, ip, stack_pos);
     if(!concrete_call) return;
   }
 
@@ -2355,7 +2614,8 @@ void StackInterpreter::ProcessJitOnlyMethodCall(StackInstr* instr, StackInstr* &
   StackMethod* concrete_call = program->GetClass(instr->GetOperand())->GetMethod(instr->GetOperand2());
 
   if(concrete_call->IsVirtual()) {
-    concrete_call = ResolveVirtualMethod(concrete_call, instance, instr, instrs, ip, stack_pos);
+    StackMethod* cached_call = instr->LookupCall(MemoryManager::GetClass(instance));
+    concrete_call = cached_call ? cached_call : ResolveVirtualMethod(concrete_call, instance, instr, instrs, ip, stack_pos);
     if(!concrete_call) return;
   }
 
@@ -2414,33 +2674,10 @@ void StackInterpreter::ProcessJitMethodCall(StackMethod* called, size_t* instanc
   JitRuntime jit_executor;
   const long status = jit_executor.Execute(called, instance, op_stack, stack_pos, call_stack, call_stack_pos, *stack_frame);
   if(status < 0) {
-    if(TryErrorRecovery(stack_pos)) {
-      return;
+    if(!TryErrorRecovery(stack_pos)) {
+      ProcessJitError(status, called);
     }
-    switch(status) {
-    case -1:
-      std::wcerr << L">>> Attempting to dereference a 'Nil' memory instance in native JIT code <<<" << std::endl;
-      break;
-
-    case -2:
-      std::wcerr << L">>> Index under bounds in native JIT code <<<" << std::endl;
-      break;
-
-    case -3:
-      std::wcerr << L">>> Index over bounds in native JIT code <<<" << std::endl;
-      break;
-
-    case -4:
-      std::wcerr << L">>> Divide by zero in native JIT code <<<" << std::endl;
-      break;
-    }
-    StackErrorUnwind(called);
-#ifdef _NO_HALT
-    halt = true;
     return;
-#else
-    exit(1);
-#endif
   }
 
   // restore previous state
@@ -2451,6 +2688,37 @@ void StackInterpreter::ProcessJitMethodCall(StackMethod* called, size_t* instanc
 #endif
 }
 
+/********************************
+ * Reports a runtime error raised
+ * by native JIT code and halts.
+ ********************************/
+void StackInterpreter::ProcessJitError(const long status, StackMethod* called)
+{
+  switch(status) {
+  case -1:
+    std::wcerr << L">>> Attempting to dereference a 'Nil' memory instance in native JIT code <<<" << std::endl;
+    break;
+
+  case -2:
+    std::wcerr << L">>> Index under bounds in native JIT code <<<" << std::endl;
+    break;
+
+  case -3:
+    std::wcerr << L">>> Index over bounds in native JIT code <<<" << std::endl;
+    break;
+
+  case -4:
+    std::wcerr << L">>> Divide by zero in native JIT code <<<" << std::endl;
+    break;
+  }
+  StackErrorUnwind(called);
+#ifdef _NO_HALT
+  halt = true;
+#else
+  exit(1);
+#endif
+}
+
 /********************************
  * Processes an interpreted
  * synchronous method call.
@@ -49,6 +49,13 @@
 
 #undef max
 
+// Direct-threaded interpreter dispatch (computed goto) where the compiler
+// supports it. Build with -D_NO_THREADED_DISPATCH for the portable switch loop;
+// MSVC and the debugger always use it.
+#if defined(__GNUC__) && !defined(_DEBUGGER) && !defined(_NO_THREADED_DISPATCH)
+#define _THREADED_DISPATCH
+#endif
+
 namespace Runtime {
 #ifdef _DEBUGGER
   class Debugger;
@@ -425,7 +432,9 @@ namespace Runtime {
     void ProcessDynamicMethodCall(StackInstr* instr, StackInstr* &instrs, long &ip, size_t* &op_stack, size_t* &stack_pos);
     void ProcessJitOnlyDynamicMethodCall(StackInstr* instr, StackInstr* &instrs, long &ip, size_t* &op_stack, size_t* &stack_pos);
     void ProcessJitMethodCall(StackMethod* called, size_t* instance, StackInstr* &instrs, long &ip, size_t* &op_stack, size_t* &stack_pos);
+    void ProcessJitError(const long status, StackMethod* called);
     void CheckAutoJit(StackMethod* called, StackInstr* instr);
+    bool ProcessOsrEntry(long target, long &ip, size_t* &op_stack, size_t* &stack_pos);
     void ProcessAsyncMethodCall(StackMethod* called, size_t* param);
 
     void ProcessInterpretedMethodCall(StackMethod* called, size_t* instance, StackInstr* &instrs, long &ip);
@@ -32,6 +32,9 @@
 #include "loader.h"
 #include "common.h"
 #include "../shared/version.h"
+#ifndef _NO_JIT
+#include "arch/jit/jit_common.h"
+#endif
 
 StackProgram* Loader::program;
 
@@ -232,6 +235,28 @@ void Loader::Load()
   std::wcout << L"Program starting point: " << start_class_id << L"," << start_method_id << std::endl;
 #endif
 
+  // Superinstructions: 'superinstructions' in config.prop, overridden by the
+  // OBJECK_SUPERINSTRUCTIONS environment variable. The debugger steps single
+  // instructions, so it never fuses.
+#ifdef _DEBUGGER
+  fuse_instrs = false;
+#else
+  std::wstring fuse_prop = StackProgram::GetProperty(L"superinstructions");
+#ifdef _WIN32
+  size_t fuse_env_len;
+  char fuse_env[SMALL_BUFFER_MAX];
+  if(!getenv_s(&fuse_env_len, fuse_env, SMALL_BUFFER_MAX, "OBJECK_SUPERINSTRUCTIONS") && strlen(fuse_env) > 0) {
+    fuse_prop = BytesToUnicode(fuse_env);
+  }
+#else
+  const char* fuse_env = getenv("OBJECK_SUPERINSTRUCTIONS");
+  if(fuse_env && strlen(fuse_env) > 0) {
+    fuse_prop = BytesToUnicode(fuse_env);
+  }
+#endif
+  fuse_instrs = fuse_prop != L"false" && fuse_prop != L"0";
+#endif
+
   LoadClasses();
   
   const std::wstring name = L"$Initialization$:";
@@ -244,6 +269,11 @@ void Loader::Load()
   LoadInitializationCode(init_method);
   program->SetInitializationMethod(init_method);
   program->SetStringObjectId(string_cls_id);
+
+#ifndef _NO_JIT
+  // native code cached by an earlier run of this image (installed by the JIT)
+  JitCodeCache::Open(program, alloc_buffer, (size_t)(buffer - alloc_buffer));
+#endif
 }
 
 char* Loader::LoadFileBuffer(std::wstring filename, size_t& buffer_size)
@@ -931,6 +961,103 @@ void Loader::LoadStatements(StackMethod* method, bool is_debug)
     }
   }
 
+  if(fuse_instrs) {
+    FuseInstructions(mthd_instrs, static_cast<long>(num_instrs));
+  }
+
   // copy and set instructions
   method->SetInstructions(mthd_instrs, static_cast<int>(num_instrs));
 }
+
+/********************************
+ * Superinstruction pass. Marks the first instruction of common sequences
+ * with a fused dispatch opcode; the interpreter runs the sequence in one
+ * handler and skips the rest. Only the dispatch opcode changes: types and
+ * operands are left alone for the JIT and the debugger, and a jump into the
+ * middle of a sequence still runs the remaining instructions one at a time.
+ ********************************/
+void Loader::FuseInstructions(StackInstr* instrs, const long num_instrs)
+{
+  long i = 0;
+  while(i + 1 < num_instrs) {
+    StackInstr* instr = &instrs[i];
+    StackInstr* next = &instrs[i + 1];
+
+    switch(instr->GetType()) {
+    case LOAD_INT_LIT:
+      if(next->GetType() == LOAD_LOCL_INT_VAR) {
+        // 'x op c' and 'i op= c'
+        const InstructionType oper = i + 2 < num_instrs ? instrs[i + 2].GetType() : END_STMTS;
+        const bool is_stor = i + 3 < num_instrs && instrs[i + 3].GetType() == STOR_LOCL_INT_VAR;
+        switch(oper) {
+        case ADD_INT:
+          instr->SetDispatchOp(is_stor ? OP_LIT_LOCL_ADD_STOR_INT : OP_LIT_LOCL_ADD_INT);
+          i += is_stor ? 4 : 3;
+          continue;
+
+        case SUB_INT:
+          instr->SetDispatchOp(is_stor ? OP_LIT_LOCL_SUB_STOR_INT : OP_LIT_LOCL_SUB_INT);
+          i += is_stor ? 4 : 3;
+          continue;
+
+        case MUL_INT:
+          instr->SetDispatchOp(OP_LIT_LOCL_MUL_INT);
+          i += 3;
+          continue;
+
+        default:
+          instr->SetDispatchOp(OP_LIT_LOCL_INT);
+          i += 2;
+          continue;
+        }
+      }
+      break;
+
+    case LOAD_LOCL_INT_VAR:
+      if(next->GetType() == LOAD_LOCL_INT_VAR) {
+        instr->SetDispatchOp(OP_LOCL_LOCL_INT);
+        i += 2;
+        continue;
+      }
+      break;
+
+    case EQL_INT:
+    case NEQL_INT:
+    case LES_INT:
+    case GTR_INT:
+    case LES_EQL_INT:
+    case GTR_EQL_INT:
+      // compare and branch; only a conditional jump consumes the result
+      if(next->GetType() == JMP && next->GetOperand2() >= 0) {
+        switch(instr->GetType()) {
+        case EQL_INT:
+          instr->SetDispatchOp(OP_EQL_INT_JMP);
+          break;
+        case NEQL_INT:
+          instr->SetDispatchOp(OP_NEQL_INT_JMP);
+          break;
+        case LES_INT:
+          instr->SetDispatchOp(OP_LES_INT_JMP);
+          break;
+        case GTR_INT:
+          instr->SetDispatchOp(OP_GTR_INT_JMP);
+          break;
+        case LES_EQL_INT:
+          instr->SetDispatchOp(OP_LES_EQL_INT_JMP);
+          break;
+        default:
+          instr->SetDispatchOp(OP_GTR_EQL_INT_JMP);
+          break;
+        }
+        i += 2;
+        continue;
+      }
+      break;
+
+    default:
+      break;
+    }
+
+    ++i;
+  }
+}
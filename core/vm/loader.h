@@ -55,6 +55,7 @@ class Loader {
   int start_method_id;
   std::map<const std::wstring, const int> params;
   bool from_mem;
+  bool fuse_instrs;
   
   // Bounds guard for the raw deserialization cursor. Bytecode (.obe/.obl) is
   // untrusted input; a truncated or crafted file must never drive a read past the
@@ -176,6 +177,7 @@ class Loader {
   StackDclr** LoadDeclarations(const int num_dclrs, const bool is_debug);
   void LoadInitializationCode(StackMethod* mthd);
   void LoadStatements(StackMethod* mthd, bool is_debug);
+  void FuseInstructions(StackInstr* instrs, const long num_instrs);
   void LoadConfiguration();
   
 public:
@@ -31,6 +31,9 @@
 
 #include "vm.h"
 #include <codecvt>
+#ifndef _NO_JIT
+#include "arch/jit/jit_common.h"
+#endif
 
 #define SUCCESS 0
 #define USAGE_ERROR -1
@@ -105,6 +108,11 @@ int Execute(int argc, const char* argv[], size_t gc_threshold)
     // which is this thread) and wait briefly for them to unwind and deregister.
     Runtime::StackInterpreter::HaltAllExcept(intpr);
     Runtime::StackInterpreter::WaitForThreadsToDrain(intpr, 2000);
+#ifndef _NO_JIT
+    // same hazard for a background compile patching call sites
+    JitCompiler::StopCompileThread();
+    JitCodeCache::Save();
+#endif
 
 #ifdef _DEBUG
     std::wcout << L"# final std::stack: pos=" << (*stack_pos) << L" #" << std::endl;
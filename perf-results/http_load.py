@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Closed-loop HTTP load generator for the built-in Objeck web server.
+
+Opens CONNECTIONS concurrent clients against localhost, each sending GET
+requests back to back for DURATION seconds, and reports requests/sec plus
+p50/p99 latency. Without --keep-alive every request uses a fresh TCP
+connection (the server answers with "Connection: close"); with it, each client
+reuses its connection for as long as the server keeps it open.
+
+Usage:
+  http_load.py [--host H] [--port P] [--path /] [--connections N]
+               [--duration SECS] [--keep-alive] [--label NAME]
+
+Prints one summary line, e.g.
+  threads: requests=41233 errors=0 rps=4123.3 p50_ms=1.92 p99_ms=9.71
+"""
+import argparse, asyncio, resource, time
+
+
+async def read_response(reader):
+    head = await reader.readuntil(b"\r\n\r\n")
+    length = 0
+    close = False
+    for line in head.split(b"\r\n")[1:]:
+        name, _, value = line.partition(b":")
+        name = name.strip().lower()
+        if name == b"content-length":
+            length = int(value.strip())
+        elif name == b"connection" and value.strip().lower() == b"close":
+            close = True
+    if length:
+        await reader.readexactly(length)
+    return close
+
+
+async def client(args, deadline, latencies, errors):
+    request = ("GET %s HTTP/1.1\r\nHost: %s\r\n%s\r\n" % (
+        args.path, args.host, "" if args.keep_alive else "Connection: close\r\n")).encode()
+    reader = writer = None
+    while time.monotonic() < deadline:
+        start = time.monotonic()
+        try:
+            if writer is None:
+                reader, writer = await asyncio.open_connection(args.host, args.port)
+            writer.write(request)
+            close = await read_response(reader)
+            latencies.append(time.monotonic() - start)
+            if close or not args.keep_alive:
+                writer.close()
+                writer = None
+        except (OSError, asyncio.IncompleteReadError, asyncio.LimitOverrunError, ValueError):
+            errors[0] += 1
+            if writer is not None:
+                writer.close()
+                writer = None
+            await asyncio.sleep(0.01)
+    if writer is not None:
+        writer.close()
+
+
+async def run(args):
+    latencies = []
+    errors = [0]
+    deadline = time.monotonic() + args.duration
+    start = time.monotonic()
+    await asyncio.gather(*(client(args, deadline, latencies, errors) for _ in range(args.connections)))
+    elapsed = time.monotonic() - start
+
+    latencies.sort()
+    count = len(latencies)
+    p50 = latencies[count // 2] * 1000 if count else 0.0
+    p99 = latencies[min(count - 1, int(count * 0.99))] * 1000 if count else 0.0
+    print("%s: requests=%d errors=%d rps=%.1f p50_ms=%.2f p99_ms=%.2f" % (
+        args.label, count, errors[0], count / elapsed, p50, p99))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="HTTP load generator")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--path", default="/")
+    parser.add_argument("--connections", type=int, default=100)
+    parser.add_argument("--duration", type=float, default=10.0)
+    parser.add_argument("--keep-alive", action="store_true")
+    parser.add_argument("--label", default="server")
+    args = parser.parse_args()
+
+    # one descriptor per client plus slack
+    soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+    wanted = max(soft, args.connections + 64)
+    if hard != resource.RLIM_INFINITY:
+        wanted = min(hard, wanted)
+    resource.setrlimit(resource.RLIMIT_NOFILE, (wanted, hard))
+
+    asyncio.run(run(args))
+
+
+if __name__ == "__main__":
+    main()
@@ -46,6 +46,12 @@ PERF_BENCHMARKS[bench_matrix_multiply]="500"
 PERF_BENCHMARKS[bench_method_dispatch]=""
 PERF_BENCHMARKS[bench_copy_prop]=""
 PERF_BENCHMARKS[bench_dead_code]=""
+PERF_BENCHMARKS[bench_alloc_threads]="8"
+PERF_BENCHMARKS[bench_virtual_dispatch]=""
+
+# Extra libraries some benchmarks link against
+declare -A PERF_LIBS
+PERF_LIBS[bench_virtual_dispatch]="gen_collect"
 
 CLBG_DIR="$(cd "$(dirname "$0")" && pwd)/../programs/tests/clbg"
 PERF_DIR="$(cd "$(dirname "$0")" && pwd)/../programs/tests/perf"
@@ -57,10 +63,15 @@ run_benchmark() {
     local name="$1"
     local src_file="$2"
     local args="$3"
+    local libs="$4"
     local exe_file="${src_file%.obs}.obe"
+    local lib_opt=""
+    if [ -n "$libs" ]; then
+        lib_opt="-lib $libs"
+    fi
 
     echo "=== Compiling $name ==="
-    $OBC -src "$src_file" -dest "$exe_file" -opt s3 2>/dev/null || {
+    $OBC -src "$src_file" $lib_opt -dest "$exe_file" -opt s3 2>/dev/null || {
         echo "WARNING: Failed to compile $name, skipping"
         return
     }
@@ -100,7 +111,7 @@ done
 for bench in "${!PERF_BENCHMARKS[@]}"; do
     src="$PERF_DIR/${bench}.obs"
     if [ -f "$src" ]; then
-        run_benchmark "$bench" "$src" "${PERF_BENCHMARKS[$bench]}"
+        run_benchmark "$bench" "$src" "${PERF_BENCHMARKS[$bench]}" "${PERF_LIBS[$bench]}"
     else
         echo "WARNING: $src not found, skipping"
     fi
@@ -0,0 +1,62 @@
+#!/bin/bash
+# Built-in web server load test: thread-per-connection vs. multiplexed, each
+# with a new connection per request (close) and with connection reuse (keep-alive)
+# Usage: ./run_http_bench.sh <deploy_dir> [connections] [duration_secs] [workers]
+#
+# Example: ./run_http_bench.sh ../../core/release/deploy-x64 1000 10 4
+#
+# Starts bench_http_server in each mode on a local port and drives it with
+# http_load.py, which reports requests/sec and p50/p99 latency. Raise the open
+# file limit (ulimit -n) before running with thousands of connections.
+
+set -e
+
+DEPLOY_DIR="${1:?Usage: $0 <deploy_dir> [connections] [duration_secs] [workers]}"
+CONNECTIONS="${2:-500}"
+DURATION="${3:-10}"
+WORKERS="${4:-$(nproc 2>/dev/null || echo 4)}"
+PORT="${HTTP_BENCH_PORT:-18080}"
+
+OBC="$DEPLOY_DIR/bin/obc"
+OBR="$DEPLOY_DIR/bin/obr"
+
+if [ ! -f "$OBC" ]; then
+    echo "ERROR: Compiler not found at $OBC"
+    exit 1
+fi
+
+if [ ! -f "$OBR" ]; then
+    echo "ERROR: Runtime not found at $OBR"
+    exit 1
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PERF_DIR="$SCRIPT_DIR/../programs/tests/perf"
+SRC_FILE="$PERF_DIR/bench_http_server.obs"
+EXE_FILE="${SRC_FILE%.obs}.obe"
+
+$OBC -src "$SRC_FILE" -lib net,json,gen_collect,cipher,net_server -dest "$EXE_FILE" -opt s3 > /dev/null
+
+SERVER_PID=""
+trap '[ -n "$SERVER_PID" ] && kill $SERVER_PID 2>/dev/null' EXIT
+
+ulimit -n $((CONNECTIONS + 256)) 2>/dev/null || true
+
+for mode in threads multiplexed; do
+    for reuse in close keep-alive; do
+        $OBR "$EXE_FILE" $mode $PORT $WORKERS > /dev/null 2>&1 &
+        SERVER_PID=$!
+        sleep 1
+
+        KEEP_ALIVE=""
+        if [ "$reuse" = "keep-alive" ]; then
+            KEEP_ALIVE="--keep-alive"
+        fi
+        python3 "$SCRIPT_DIR/http_load.py" --port $PORT --connections $CONNECTIONS \
+            --duration $DURATION --label "$mode/$reuse" $KEEP_ALIVE
+
+        kill $SERVER_PID 2>/dev/null || true
+        wait $SERVER_PID 2>/dev/null || true
+        SERVER_PID=""
+    done
+done
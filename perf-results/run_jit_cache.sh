@@ -0,0 +1,42 @@
+#!/bin/bash
+# JIT code cache warmup benchmark: cold cache vs. warm cache
+# Usage: ./run_jit_cache.sh <deploy_dir> [num_runs]
+#
+# Example: ./run_jit_cache.sh ../../core/release/deploy-x64 5
+#
+# Each run starts from an empty OBJECK_JIT_CACHE directory; the first execution
+# compiles from scratch and saves its native code, the second installs it.
+
+set -e
+
+DEPLOY_DIR="${1:?Usage: $0 <deploy_dir> [num_runs]}"
+NUM_RUNS="${2:-5}"
+
+OBC="$DEPLOY_DIR/bin/obc"
+OBR="$DEPLOY_DIR/bin/obr"
+
+if [ ! -f "$OBC" ]; then
+    echo "ERROR: Compiler not found at $OBC"
+    exit 1
+fi
+
+if [ ! -f "$OBR" ]; then
+    echo "ERROR: Runtime not found at $OBR"
+    exit 1
+fi
+
+PERF_DIR="$(cd "$(dirname "$0")" && pwd)/../programs/tests/perf"
+SRC_FILE="$PERF_DIR/bench_jit_warmup.obs"
+EXE_FILE="${SRC_FILE%.obs}.obe"
+
+$OBC -src "$SRC_FILE" -dest "$EXE_FILE" -opt s3 > /dev/null
+
+CACHE_DIR=$(mktemp -d)
+trap 'rm -rf "$CACHE_DIR"' EXIT
+
+for run in $(seq 1 "$NUM_RUNS"); do
+    rm -f "$CACHE_DIR"/*
+    echo "Run $run"
+    echo "  cold: $(OBJECK_JIT_CACHE="$CACHE_DIR" $OBR "$EXE_FILE")"
+    echo "  warm: $(OBJECK_JIT_CACHE="$CACHE_DIR" $OBR "$EXE_FILE")"
+done
@@ -0,0 +1,130 @@
+#!/bin/bash
+# Differential test for interpreter dispatch: runs every regression test under
+# the deployed VM (direct-threaded dispatch, superinstructions) and under a
+# reference VM built with -D_NO_THREADED_DISPATCH (switch dispatch) with
+# superinstructions turned off, then compares exit codes and output.
+#
+# Usage: ./run_dispatch_diff.sh <reference_obr> [x64|arm64]
+#
+# Build the reference VM by adding -D_NO_THREADED_DISPATCH to ARGS in
+# core/vm/Makefile (or make/Makefile.<arch>) and copying the resulting obr
+# aside. Both VMs run with the JIT disabled so every test is interpreted.
+# Tests whose output is not deterministic (timings, thread interleaving,
+# random numbers) carry a '# DISPATCH_DIFF_SKIP' marker.
+
+REF_VM="${1:?Usage: $0 <reference_obr> [x64|arm64]}"
+PLATFORM=${2:-x64}
+
+if [ -d "../../core/release/deploy-${PLATFORM}" ]; then
+    DEPLOY_DIR="../../core/release/deploy-${PLATFORM}"
+elif [ -d "../../core/release/deploy" ]; then
+    DEPLOY_DIR="../../core/release/deploy"
+else
+    echo "ERROR: Could not find deployment directory"
+    echo "Expected: ../../core/release/deploy-${PLATFORM} or ../../core/release/deploy"
+    exit 1
+fi
+
+COMPILER="${DEPLOY_DIR}/bin/obc"
+VM="${DEPLOY_DIR}/bin/obr"
+RESULTS_DIR="./results/dispatch"
+
+mkdir -p "$RESULTS_DIR"
+
+REGRESSION_DIR=$(pwd)
+ABS_COMPILER=$(cd "$(dirname "$COMPILER")" && pwd)/$(basename "$COMPILER")
+ABS_VM=$(cd "$(dirname "$VM")" && pwd)/$(basename "$VM")
+ABS_REF_VM=$(cd "$(dirname "$REF_VM")" && pwd)/$(basename "$REF_VM")
+NATIVE_LIB_DIR=$(cd "$(dirname "$COMPILER")/../lib/native" 2>/dev/null && pwd)
+
+ABS_LIB_DIR=$(cd "$(dirname "$COMPILER")/../lib" 2>/dev/null && pwd)
+if [ -d "$ABS_LIB_DIR" ]; then
+    export OBJECK_LIB_PATH="$ABS_LIB_DIR"
+fi
+if [ -d "$NATIVE_LIB_DIR" ]; then
+    export LD_LIBRARY_PATH="${NATIVE_LIB_DIR}:${LD_LIBRARY_PATH}"
+    export DYLD_LIBRARY_PATH="${NATIVE_LIB_DIR}:${DYLD_LIBRARY_PATH}"
+fi
+
+TEST_TIMEOUT=${TEST_TIMEOUT:-60}
+if command -v timeout >/dev/null 2>&1; then
+    TIMEOUT="timeout ${TEST_TIMEOUT}"
+elif command -v gtimeout >/dev/null 2>&1; then
+    TIMEOUT="gtimeout ${TEST_TIMEOUT}"
+else
+    TIMEOUT=""
+fi
+
+SAME_COUNT=0
+DIFF_COUNT=0
+SKIP_COUNT=0
+DIFF_TESTS=()
+
+echo "========================================"
+echo "  Objeck Dispatch Differential Test"
+echo "  VM:        $ABS_VM"
+echo "  Reference: $ABS_REF_VM"
+echo "========================================"
+echo ""
+
+for test in *.obs; do
+    [ -f "$test" ] || continue
+    NAME="${test%.obs}"
+
+    # compile errors are covered by run_regression.sh
+    if grep -q '# EXPECT_COMPILE_ERROR\|# DISPATCH_DIFF_SKIP' "$test" 2>/dev/null; then
+        ((SKIP_COUNT++))
+        continue
+    fi
+
+    LIBS="cipher,collect,xml,json"
+    EXTRA=$(grep -m1 '# EXTRA_LIBS:' "$test" 2>/dev/null | sed 's/.*# EXTRA_LIBS:[[:space:]]*//')
+    if [ -n "$EXTRA" ]; then
+        LIBS="${LIBS},${EXTRA}"
+    fi
+
+    cd "${DEPLOY_DIR}/bin"
+    "$ABS_COMPILER" -src "${REGRESSION_DIR}/${test}" -lib "$LIBS" -opt s3 -dest "${REGRESSION_DIR}/${NAME}.obe" > /dev/null 2>&1
+    COMPILE_EXIT=$?
+    cd "$REGRESSION_DIR"
+    if [ $COMPILE_EXIT -ne 0 ]; then
+        ((SKIP_COUNT++))
+        continue
+    fi
+
+    $TIMEOUT env OBJECK_JIT_DISABLE=1 "$ABS_VM" "$NAME.obe" > "$RESULTS_DIR/${NAME}_vm.txt" 2>&1
+    VM_EXIT=$?
+    $TIMEOUT env OBJECK_JIT_DISABLE=1 OBJECK_SUPERINSTRUCTIONS=0 "$ABS_REF_VM" "$NAME.obe" > "$RESULTS_DIR/${NAME}_ref.txt" 2>&1
+    REF_EXIT=$?
+
+    # error unwinding prints frame addresses, which differ from run to run
+    sed -i -E 's/0x[0-9a-fA-F]+/0x?/g' "$RESULTS_DIR/${NAME}_vm.txt" "$RESULTS_DIR/${NAME}_ref.txt"
+
+    if [ $VM_EXIT -ne $REF_EXIT ]; then
+        echo "  [DIFF] $NAME: exit $VM_EXIT vs $REF_EXIT"
+        DIFF_TESTS+=("$NAME")
+        ((DIFF_COUNT++))
+    elif ! cmp -s "$RESULTS_DIR/${NAME}_vm.txt" "$RESULTS_DIR/${NAME}_ref.txt"; then
+        echo "  [DIFF] $NAME: output"
+        diff "$RESULTS_DIR/${NAME}_ref.txt" "$RESULTS_DIR/${NAME}_vm.txt" | head -10
+        DIFF_TESTS+=("$NAME")
+        ((DIFF_COUNT++))
+    else
+        ((SAME_COUNT++))
+    fi
+done
+
+echo ""
+echo "========================================"
+echo "  Results: $SAME_COUNT same, $DIFF_COUNT different, $SKIP_COUNT skipped"
+echo "========================================"
+
+if [ $DIFF_COUNT -gt 0 ]; then
+    echo ""
+    echo "Different:"
+    for t in "${DIFF_TESTS[@]}"; do
+        echo "  ✗ ${t}"
+    done
+fi
+
+[ $DIFF_COUNT -eq 0 ] && exit 0 || exit 1